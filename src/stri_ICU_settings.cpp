@@ -31,6 +31,8 @@
 
 
 #include "stri_stringi.h"
+#include "stri_cache.h"
+#include "stri_parallel.h"
 
 
 #ifndef STRI_ICU_FOUND
@@ -47,6 +49,7 @@
  *  \code{Charset.native} == \code{stri_enc_info()})
  *  \code{ICU.system} == is system ICU used?
  *  \code{ICU.UTF8} == is U_CHARSET_IS_UTF8 set?
+ *  \code{Cache} == statistics on the internal object caches
  *
  *  @version 0.1-?? (Marek Gagolewski)
  *
@@ -65,11 +68,13 @@
  * @version 1.3.1 (Marek Gagolewski, 2019-02-06)
  *    new retval field: ICU.UTF8
  *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    new retval field: Cache
  */
 SEXP stri_info()
 {
     STRI__ERROR_HANDLER_BEGIN(0)
-    const R_len_t infosize = 7;
+    const R_len_t infosize = 8;
     SEXP vals;
 
     STRI__PROTECT(vals = Rf_allocVector(VECSXP, infosize));
@@ -88,11 +93,167 @@ SEXP stri_info()
 #endif
 #endif
 
+    SEXP cache;
+    STRI__PROTECT(cache = Rf_allocVector(VECSXP, 5));
+    SET_VECTOR_ELT(cache, 0, stri__regex_pattern_cache_base.getInfo());
+    SET_VECTOR_ELT(cache, 1, stri__transliterator_cache_base.getInfo());
+    SET_VECTOR_ELT(cache, 2, stri__collator_cache_base.getInfo());
+    SET_VECTOR_ELT(cache, 3, stri__conversion_cache_base.getInfo());
+    SET_VECTOR_ELT(cache, 4, stri__brkiter_cache_base.getInfo());
+    stri__set_names(cache, 5, "regex", "transliterator", "collator", "conversion", "brkiter");
+    SET_VECTOR_ELT(vals, 7, cache);
+
     stri__set_names(vals, infosize,
                     "Unicode.version", "ICU.version", "Locale",
-                    "Charset.internal", "Charset.native", "ICU.system", "ICU.UTF8");
+                    "Charset.internal", "Charset.native", "ICU.system", "ICU.UTF8",
+                    "Cache");
 
     STRI__UNPROTECT_ALL
     return vals;
     STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
 }
+
+
+static SEXP stri__options_get_threads()
+{
+    return Rf_ScalarInteger(stri__parallel_get_threads());
+}
+
+
+static void stri__options_set_threads(SEXP val)
+{
+    int nthreads = stri__prepare_arg_integer_1_notNA(val, "threads");
+    if (nthreads < 1) Rf_error(MSG__INCORRECT_NAMED_ARG "; " MSG__EXPECTED_POSITIVE, "threads");
+    stri__parallel_set_threads(nthreads);
+}
+
+
+/** Describes a package-wide option, see stri_options()
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriOption {
+    const char* name;      ///< option name
+    SEXP (*get)();         ///< returns the current value
+    void (*set)(SEXP);     ///< sets a new value; may call Rf_error
+    StriCacheBase* cache;  ///< if not NULL, the option is this cache's capacity (get and set are unused)
+};
+
+
+/** List of all options available via stri_options(); must be NULL-terminated;
+ *  every process-wide cache is registered here */
+static const StriOption stri__options[] = {
+    {"regex_cache_size",          NULL,                      NULL,                      &stri__regex_pattern_cache_base},
+    {"transliterator_cache_size", NULL,                      NULL,                      &stri__transliterator_cache_base},
+    {"collator_cache_size",       NULL,                      NULL,                      &stri__collator_cache_base},
+    {"conversion_cache_size",     NULL,                      NULL,                      &stri__conversion_cache_base},
+    {"brkiter_cache_size",        NULL,                      NULL,                      &stri__brkiter_cache_base},
+    {"threads",                   stri__options_get_threads, stri__options_set_threads, NULL},
+    {NULL,                        NULL,                      NULL,                      NULL}
+};
+
+
+/** Get the current value of an option
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static SEXP stri__options_get(const StriOption& opt)
+{
+    if (opt.cache)
+        return Rf_ScalarInteger(opt.cache->getCapacity());
+    return opt.get();
+}
+
+
+/** Set a new value of an option; may call Rf_error
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static void stri__options_set(const StriOption& opt, SEXP val)
+{
+    if (!opt.cache) {
+        opt.set(val);
+        return;
+    }
+
+    int size = stri__prepare_arg_integer_1_notNA(val, opt.name);
+    if (size < 0) Rf_error(MSG__INCORRECT_NAMED_ARG "; " MSG__EXPECTED_NONNEGATIVE, opt.name);
+    opt.cache->setCapacity(size);
+}
+
+
+/** Dispose of the objects kept in all the registered caches
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+void stri__caches_clear()
+{
+    for (R_len_t j=0; stri__options[j].name; ++j)
+        if (stri__options[j].cache) stri__options[j].cache->clear();
+}
+
+
+/** Get or set package-wide options
+ *
+ * @param opts a named list with new option values or NULL
+ * @return if opts is empty, a named list with all the current settings;
+ *    otherwise, a named list with the previous values of the modified options
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+SEXP stri_options(SEXP opts)
+{
+    if (!Rf_isNull(opts) && !Rf_isVectorList(opts))
+        Rf_error(MSG__ARG_EXPECTED_LIST, "opts"); // error() call allowed here
+
+    R_len_t narg = Rf_isNull(opts)?0:LENGTH(opts);
+
+    SEXP ret, names;
+    if (narg <= 0) {
+        R_len_t nopts = 0;
+        while (stri__options[nopts].name) ++nopts;
+
+        PROTECT(ret = Rf_allocVector(VECSXP, nopts));
+        PROTECT(names = Rf_allocVector(STRSXP, nopts));
+        for (R_len_t j=0; j<nopts; ++j) {
+            SET_VECTOR_ELT(ret, j, stri__options_get(stri__options[j]));
+            SET_STRING_ELT(names, j, Rf_mkChar(stri__options[j].name));
+        }
+        Rf_setAttrib(ret, R_NamesSymbol, names);
+        UNPROTECT(2);
+        return ret;
+    }
+
+    SEXP optnames = PROTECT(Rf_getAttrib(opts, R_NamesSymbol));
+    if (optnames == R_NilValue || LENGTH(optnames) != narg)
+        Rf_error(MSG__INCORRECT_NAMED_ARG, "opts"); // error() call allowed here
+
+    PROTECT(ret = Rf_allocVector(VECSXP, narg));
+    PROTECT(names = Rf_allocVector(STRSXP, narg));
+    for (R_len_t i=0; i<narg; ++i) {
+        if (STRING_ELT(optnames, i) == NA_STRING)
+            Rf_error(MSG__INCORRECT_NAMED_ARG, "opts"); // error() call allowed here
+
+        SEXP tmp_arg;
+        PROTECT(tmp_arg = STRING_ELT(optnames, i));
+        const char* curname = stri__copy_string_Ralloc(tmp_arg, "curname");  /* this is R_alloc'ed */
+        UNPROTECT(1);
+
+        SET_STRING_ELT(names, i, Rf_mkChar(curname));
+
+        R_len_t j = 0;
+        while (stri__options[j].name && strcmp(curname, stri__options[j].name)) ++j;
+
+        if (!stri__options[j].name) {
+            Rf_warning(MSG__INCORRECT_STRI_OPTION, curname);
+            SET_VECTOR_ELT(ret, i, R_NilValue);
+            continue;
+        }
+
+        SET_VECTOR_ELT(ret, i, stri__options_get(stri__options[j]));
+        stri__options_set(stri__options[j], VECTOR_ELT(opts, i));
+    }
+    Rf_setAttrib(ret, R_NamesSymbol, names);
+    UNPROTECT(3);
+    return ret;
+}
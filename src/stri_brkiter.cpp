@@ -31,6 +31,143 @@
 
 #include "stri_stringi.h"
 #include "stri_brkiter.h"
+#include "stri_cache.h"
+#include <string>
+
+
+/** Default capacity of the break iterator cache,
+ *  see stri_options(brkiter_cache_size=...)
+ */
+#define STRI__BRKITER_CACHE_SIZE_DEFAULT 32
+
+
+/** A key to the break iterator cache
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriBrkIterCacheKey {
+    UnicodeString rules;  ///< custom rules; then type and locale are ignored
+    int type;
+    std::string locale;
+
+    StriBrkIterCacheKey(UBreakIteratorType _type, const UnicodeString& _rules, const char* _locale)
+        : rules(_rules), type(_type), locale((_locale && _rules.isEmpty())?_locale:"")
+    {
+        if (!rules.isEmpty()) type = -1;
+    }
+
+    bool operator<(const StriBrkIterCacheKey& other) const {
+        if (type != other.type) return type < other.type;
+        if (locale != other.locale) return locale < other.locale;
+        return rules < other.rules;
+    }
+};
+
+
+/** An item of the break iterator cache: a prototype to be cloned
+ *  and the (warning) status returned when it was created
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriBrkIterCacheEntry {
+    BreakIterator* iterator;
+    UErrorCode status;
+
+    StriBrkIterCacheEntry(BreakIterator* _iterator, UErrorCode _status)
+        : iterator(_iterator), status(_status) { }
+};
+
+
+struct StriBrkIterCacheDeleter {
+    void operator()(StriBrkIterCacheEntry* entry) const {
+        delete entry->iterator;
+        delete entry;
+    }
+};
+
+
+/** Break iterators shared by all the functions that rely on text boundary analysis */
+static StriLRUCache<StriBrkIterCacheKey, StriBrkIterCacheEntry*, StriBrkIterCacheDeleter>
+    stri__brkiter_cache(STRI__BRKITER_CACHE_SIZE_DEFAULT);
+
+StriCacheBase& stri__brkiter_cache_base = stri__brkiter_cache;
+
+
+/** Get a break iterator, reusing the process-wide cache if possible
+ *
+ * Creating a break iterator means loading (and, in the case of custom
+ * rules, compiling) the break rules and, for word and line breaking,
+ * the dictionaries for languages such as Thai, Chinese, or Japanese;
+ * a clone shares this (immutable) data with the original.
+ *
+ * @param type break iterator type (ignored if rules are given)
+ * @param rules custom break rules or an empty string
+ * @param locale locale ID (ignored if rules are given)
+ * @param status [out] ICU error code; on success, a warning is
+ *    reported as if a new iterator was created
+ * @return a new BreakIterator object (owned by the caller) or NULL on error
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+BreakIterator* stri__brkiter_create(
+    UBreakIteratorType type, const UnicodeString& rules, const char* locale,
+    UErrorCode& status
+) {
+    StriBrkIterCacheKey key(type, rules, locale);
+    StriBrkIterCacheEntry* cached = stri__brkiter_cache.get(key);
+    if (cached) {
+        BreakIterator* ret = cached->iterator->clone();
+        if (!ret) status = U_MEMORY_ALLOCATION_ERROR;
+        else status = cached->status;
+        return ret;
+    }
+
+    BreakIterator* brkiter = NULL;
+    if (!rules.isEmpty()) {
+        UParseError parseErr;
+        brkiter = (BreakIterator*) new RuleBasedBreakIterator(
+            rules, parseErr, status
+        );
+    }
+    else {
+        Locale loc = Locale::createFromName(locale);
+        switch (type) {
+        case UBRK_CHARACTER: // character
+            brkiter = BreakIterator::createCharacterInstance(loc, status);
+            break;
+        case UBRK_LINE: // line_break
+            brkiter = BreakIterator::createLineInstance(loc, status);
+            break;
+        case UBRK_SENTENCE: // sentence
+            brkiter = BreakIterator::createSentenceInstance(loc, status);
+            break;
+        case UBRK_WORD: // word
+            brkiter = BreakIterator::createWordInstance(loc, status);
+            break;
+        default:
+            throw StriException(MSG__INTERNAL_ERROR);
+        }
+    }
+
+    if (U_FAILURE(status)) {
+        // do not cache incorrect rules
+        if (brkiter) delete brkiter;
+        return NULL;
+    }
+
+    if (!brkiter) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+
+    if (stri__brkiter_cache.getCapacity() <= 0)
+        return brkiter;  // caching disabled
+
+    stri__brkiter_cache.put(key, new StriBrkIterCacheEntry(brkiter, status));  // now owned by the cache
+    BreakIterator* ret = brkiter->clone();
+    if (!ret) status = U_MEMORY_ALLOCATION_ERROR;
+    return ret;
+}
 
 
 /** Select Break Iterator
@@ -41,6 +41,12 @@
 #include <unicode/uloc.h>
 #include <unicode/locid.h>
 
+// brkiter.cpp:
+BreakIterator* stri__brkiter_create(
+    UBreakIteratorType type, const UnicodeString& rules, const char* locale,
+    UErrorCode& status);
+
+
 /**
  * A class to manage a break iterator's options
  *
@@ -91,111 +97,6 @@ public:
 };
 
 
-/**
- * A class to manage a break iterator
- *
- * @version 0.3-1 (Marek Gagolewski, 2014-10-30)
- *
- * @version 0.4-1 (Marek Gagolewski, 2014-12-02) separate class
- *
- * @version 1.1.3 (Marek Gagolewski, 2017-01-07) UBRK_COUNT deprecated
- *
- * @version 1.1.6 (Marek Gagolewski, 2017-04-22) Add support for RBBI
- *
- * @version 1.8.1 (Marek Gagolewski, 2023-11-09)
- *     warn if resource bundle for an explicitly set locale is unavailable
- */
-class StriUBreakIterator : public StriBrkIterOptions {
-private:
-
-    UBreakIterator* uiterator;
-
-    void open() {
-#ifndef NDEBUG
-        if (uiterator) throw StriException("!NDEBUG: StriUBreakIterator::open()");
-#endif
-        UErrorCode status = U_ZERO_ERROR;
-        if (!rules.isEmpty()) {
-            UParseError parseErr;
-            uiterator = ubrk_openRules(rules.getTerminatedBuffer(),
-                                       -1/*null-terminated*/, NULL, 0,
-                                       &parseErr, &status);
-        }
-        else {
-            switch (type) {
-            case UBRK_CHARACTER: // character
-                uiterator = ubrk_open(UBRK_CHARACTER, locale, NULL, 0, &status);
-                break;
-            case UBRK_LINE: // line_break
-                uiterator = ubrk_open(UBRK_LINE, locale, NULL, 0, &status);
-                break;
-            case UBRK_SENTENCE: // sentence
-                uiterator = ubrk_open(UBRK_SENTENCE, locale, NULL, 0, &status);
-                break;
-            case UBRK_WORD: // word
-                uiterator = ubrk_open(UBRK_WORD, locale, NULL, 0, &status);
-                break;
-            default:
-                throw StriException(MSG__INTERNAL_ERROR);
-            }
-        }
-        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-
-        if (status == U_USING_DEFAULT_WARNING && uiterator && locale) {
-            UErrorCode status2 = U_ZERO_ERROR;
-            const char* valid_locale = ubrk_getLocaleByType(uiterator, ULOC_VALID_LOCALE, &status2);
-            if (valid_locale && !strcmp(valid_locale, "root"))
-                Rf_warning("%s", ICUError::getICUerrorName(status));
-        }
-    }
-
-
-public:
-
-    StriUBreakIterator()
-        : StriBrkIterOptions() {
-        uiterator = NULL;
-    }
-
-    StriUBreakIterator(const StriBrkIterOptions& bropt)
-        : StriBrkIterOptions(bropt) {
-        uiterator = NULL;
-    }
-
-    StriUBreakIterator& operator=(const StriBrkIterOptions& bropt) {
-        this->~StriUBreakIterator();
-        (StriBrkIterOptions&) (*this) = (StriBrkIterOptions&)bropt;
-        uiterator = NULL;
-        return *this;
-    }
-
-    ~StriUBreakIterator() {
-        if (uiterator) {
-            ubrk_close(uiterator);
-            uiterator = NULL;
-        }
-    }
-
-    void free(bool dealloc=true) {
-        if (uiterator && dealloc) {
-            ubrk_close(uiterator);
-        }
-        uiterator = NULL;
-    }
-
-
-    UBreakIterator* getIterator() {
-        if (!uiterator) open();
-        return uiterator;
-    }
-
-
-    const char* getLocale() {
-        return locale;
-    }
-};
-
-
 /**
  * A class to manage a break iterator
  *
@@ -208,6 +109,10 @@ public:
  *
  * @version 1.8.1 (Marek Gagolewski, 2023-11-09)
  *     warn if resource bundle for an explicitly set locale is unavailable
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *     clone the iterators kept in a process-wide cache;
+ *     getIterator() and getLocale() (StriUBreakIterator has been removed)
  */
 class StriRuleBasedBreakIterator : public StriBrkIterOptions {
 private:
@@ -228,32 +133,7 @@ private:
 
     void open() {
         UErrorCode status = U_ZERO_ERROR;
-        Locale loc = Locale::createFromName(locale);
-        if (!rules.isEmpty()) {
-            UParseError parseErr;
-            rbiterator = (BreakIterator*) new RuleBasedBreakIterator(
-                             UnicodeString(rules), parseErr, status
-                         );
-        }
-        else {
-            switch (type) {
-            case UBRK_CHARACTER: // character
-                rbiterator = (BreakIterator*)BreakIterator::createCharacterInstance(loc, status);
-                break;
-            case UBRK_LINE: // line_break
-                rbiterator = (BreakIterator*)BreakIterator::createLineInstance(loc, status);
-                break;
-            case UBRK_SENTENCE: // sentence
-                rbiterator = (BreakIterator*)BreakIterator::createSentenceInstance(loc, status);
-                break;
-            case UBRK_WORD: // word
-                rbiterator = (BreakIterator*)BreakIterator::createWordInstance(loc, status);
-                break;
-            default:
-                throw StriException(MSG__INTERNAL_ERROR);
-            }
-
-        }
+        rbiterator = stri__brkiter_create(type, rules, locale, status);
         STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
 
         if (status == U_USING_DEFAULT_WARNING && rbiterator && locale) {
@@ -299,6 +179,15 @@ public:
 
     void setupMatcher(const char* searchStr, R_len_t searchLen);
 
+    BreakIterator* getIterator() {  // owned by this object
+        if (!rbiterator) open();
+        return rbiterator;
+    }
+
+    const char* getLocale() {
+        return locale;
+    }
+
     void first();
     bool next();
     bool next(std::pair<R_len_t, R_len_t>& bdr);
@@ -0,0 +1,388 @@
+/* This file is part of the 'stringi' project.
+ * Copyright (c) 2013-2026, Marek Gagolewski <https://www.gagolewski.com/>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef __stri_bytesearch_dict_h
+#define __stri_bytesearch_dict_h
+
+
+#include "stri_stringi.h"
+#include "stri_container_utf8.h"
+#include <vector>
+#include <map>
+
+
+/**
+ * Aho-Corasick automaton finding all occurrences of many fixed patterns
+ * in a single pass over a UTF-8 string
+ *
+ * In the case-sensitive mode, the automaton consumes bytes;
+ * otherwise, it consumes upper-cased code points
+ * (compare StriByteSearchMatcherKMPci).
+ *
+ * findNext() reports all the occurrences in the order of their end
+ * positions; all the patterns ending at the same position are reported
+ * one after another. findNextLongest() reports the non-overlapping
+ * leftmost-longest ones. Patterns are identified by their indexes in the dictionary;
+ * NA and empty patterns never match.
+ *
+ * In the case-insensitive mode, only valid UTF-8 strings can be searched in,
+ * see isSearchable(); ill-formed patterns never match then.
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriByteSearchDict {
+
+private:
+
+    StriByteSearchDict(const StriByteSearchDict&); /* no copy-able */
+    StriByteSearchDict& operator=(const StriByteSearchDict&);
+
+    bool m_caseInsensitive;
+
+    std::vector<R_len_t> m_patternLen;  // in symbols (bytes or code points); 0 for NA/empty
+    std::vector<R_len_t> m_patternNext; // next pattern with the same contents or -1
+
+    R_len_t m_rootNext[256];            // root's transitions for symbols < 256
+    std::vector<R_len_t> m_edgeStart;   // node's edges: [m_edgeStart[k], m_edgeStart[k+1])
+    std::vector<UChar32> m_edgeSym;     // sorted increasingly for each node
+    std::vector<R_len_t> m_edgeTo;
+    std::vector<R_len_t> m_fail;        // failure links
+    std::vector<R_len_t> m_output;      // first pattern ending at a node or -1
+    std::vector<R_len_t> m_outputLink;  // nearest proper suffix node with an output or -1
+    std::vector<R_len_t> m_depth;       // node's distance from the root (in symbols)
+
+    const char* m_searchStr; // owned by caller
+    R_len_t m_searchLen;     // in bytes
+    R_len_t m_searchPos;     // byte index of the next symbol to consume
+    R_len_t m_state;
+    R_len_t m_curNode;
+    R_len_t m_curPattern;
+
+
+    inline R_len_t getChild(R_len_t node, UChar32 c) const {
+        if (node == 0 && c >= 0 && c < 256)
+            return m_rootNext[c];
+
+        R_len_t a = m_edgeStart[node], b = m_edgeStart[node+1];
+        while (a < b) {  // binary search
+            R_len_t m = a + (b-a)/2;
+            if (m_edgeSym[m] < c) a = m+1;
+            else b = m;
+        }
+        if (a < m_edgeStart[node+1] && m_edgeSym[a] == c)
+            return m_edgeTo[a];
+        else
+            return (node == 0)?0:-1;
+    }
+
+
+    inline R_len_t getNextState(R_len_t node, UChar32 c) const {
+        while (true) {
+            R_len_t next = getChild(node, c);
+            if (next >= 0) return next;
+            node = m_fail[node];
+        }
+    }
+
+
+    /** byte index in searchStr that is k symbols before the current position */
+    inline R_len_t getPosBack(R_len_t k) const {
+        if (!m_caseInsensitive)
+            return m_searchPos-k;
+
+        R_len_t pos = m_searchPos;
+        for (; k>0; --k)
+            U8_BACK_1((const uint8_t*)m_searchStr, 0, pos);
+        return pos;
+    }
+
+
+    inline UChar32 getNextSymbol() {
+        if (!m_caseInsensitive)
+            return (UChar32)(uint8_t)m_searchStr[m_searchPos++];
+
+        UChar32 c = 0;
+        U8_NEXT(m_searchStr, m_searchPos, m_searchLen, c);
+        return u_toupper(c);
+    }
+
+
+public:
+
+    /** Build the automaton
+     *
+     * @param dict patterns (must not be modified or destroyed
+     *    while this object is in use)
+     * @param caseInsensitive whether a simple case folding should be applied
+     */
+    StriByteSearchDict(StriContainerUTF8& dict, bool caseInsensitive)
+    {
+        m_caseInsensitive = caseInsensitive;
+        m_searchStr = NULL;
+        m_searchLen = 0;
+
+        R_len_t n = dict.get_n();
+        m_patternLen.assign(n, 0);
+        m_patternNext.assign(n, -1);
+
+        // 1. build the trie
+        std::vector< std::map<UChar32, R_len_t> > children(1);
+        m_output.assign(1, -1);
+        m_depth.assign(1, 0);
+        std::vector<R_len_t> lastPattern(1, -1);  // the last pattern in the chain
+        for (R_len_t i=0; i<n; ++i) {
+            if (dict.isNA(i) || dict.get(i).length() <= 0)
+                continue;
+
+            const char* s = dict.get(i).c_str();
+            R_len_t s_n = dict.get(i).length();
+            R_len_t node = 0;
+            R_len_t j = 0;
+            while (j < s_n) {
+                UChar32 c;
+                if (!caseInsensitive)
+                    c = (UChar32)(uint8_t)s[j++];
+                else {
+                    U8_NEXT(s, j, s_n, c);
+                    c = u_toupper(c);
+                }
+                ++m_patternLen[i];
+
+                std::map<UChar32, R_len_t>::iterator it = children[node].find(c);
+                if (it != children[node].end())
+                    node = it->second;
+                else {
+                    R_len_t next = (R_len_t)children.size();
+                    children[node][c] = next;
+                    children.push_back(std::map<UChar32, R_len_t>());
+                    m_output.push_back(-1);
+                    m_depth.push_back(m_depth[node]+1);
+                    lastPattern.push_back(-1);
+                    node = next;
+                }
+            }
+
+            if (m_output[node] < 0)
+                m_output[node] = i;
+            else
+                m_patternNext[lastPattern[node]] = i;
+            lastPattern[node] = i;
+        }
+
+        // 2. flatten the trie
+        R_len_t nodes = (R_len_t)children.size();
+        m_edgeStart.resize(nodes+1);
+        m_edgeStart[0] = 0;
+        for (R_len_t k=0; k<nodes; ++k)
+            m_edgeStart[k+1] = m_edgeStart[k] + (R_len_t)children[k].size();
+        m_edgeSym.resize(m_edgeStart[nodes]);
+        m_edgeTo.resize(m_edgeStart[nodes]);
+        for (R_len_t k=0; k<nodes; ++k) {
+            R_len_t e = m_edgeStart[k];
+            for (std::map<UChar32, R_len_t>::iterator it = children[k].begin();
+                    it != children[k].end(); ++it, ++e) {
+                m_edgeSym[e] = it->first;
+                m_edgeTo[e] = it->second;
+            }
+            children[k].clear();
+        }
+
+        for (R_len_t c=0; c<256; ++c)
+            m_rootNext[c] = 0;
+        for (R_len_t e=m_edgeStart[0]; e<m_edgeStart[1]; ++e) {
+            if (m_edgeSym[e] >= 0 && m_edgeSym[e] < 256)
+                m_rootNext[m_edgeSym[e]] = m_edgeTo[e];
+        }
+
+        // 3. compute the failure and output links (BFS)
+        m_fail.assign(nodes, 0);
+        m_outputLink.assign(nodes, -1);
+        std::vector<R_len_t> queue;
+        queue.reserve(nodes);
+        queue.push_back(0);
+        for (size_t q=0; q<queue.size(); ++q) {
+            R_len_t node = queue[q];
+            for (R_len_t e=m_edgeStart[node]; e<m_edgeStart[node+1]; ++e) {
+                R_len_t child = m_edgeTo[e];
+                if (node != 0) {
+                    R_len_t f = getNextState(m_fail[node], m_edgeSym[e]);
+                    m_fail[child] = f;
+                    m_outputLink[child] = (m_output[f] >= 0)?f:m_outputLink[f];
+                }
+                queue.push_back(child);
+            }
+        }
+
+        reset(NULL, 0);
+    }
+
+
+    /** Can a given string be searched in?
+     *
+     * In the case-insensitive mode, the string must be valid UTF-8:
+     * U8_NEXT and U8_BACK_1 are consistent with each other on valid
+     * UTF-8 only, and all ill-formed sequences would be mapped
+     * to the same symbol (and thus match each other).
+     *
+     * @param searchStr string to search in
+     * @param searchLen its length in bytes
+     */
+    inline bool isSearchable(const char* searchStr, R_len_t searchLen) const {
+        return !m_caseInsensitive || stri__utf8_is_valid(searchStr, searchLen);
+    }
+
+
+    /** Start a new search
+     *
+     * @param searchStr string to search in (owned by caller),
+     *    see isSearchable()
+     * @param searchLen its length in bytes
+     */
+    void reset(const char* searchStr, R_len_t searchLen) {
+        m_searchStr = searchStr;
+        m_searchLen = searchLen;
+        m_searchPos = 0;
+        m_state = 0;
+        m_curNode = -1;
+        m_curPattern = -1;
+    }
+
+
+    /** Find the next occurrence of any pattern
+     *
+     * @return the index of the matching pattern or -1 if there are
+     *    no more matches
+     */
+    R_len_t findNext() {
+        while (true) {
+            if (m_curPattern >= 0) {  // another pattern with the same contents
+                m_curPattern = m_patternNext[m_curPattern];
+                if (m_curPattern >= 0) return m_curPattern;
+            }
+
+            if (m_curNode >= 0) {  // a pattern that is a suffix of the current one
+                m_curNode = m_outputLink[m_curNode];
+                if (m_curNode >= 0) return (m_curPattern = m_output[m_curNode]);
+            }
+
+            if (m_searchPos >= m_searchLen)
+                return -1;
+
+            m_state = getNextState(m_state, getNextSymbol());
+            m_curNode = (m_output[m_state] >= 0)?m_state:m_outputLink[m_state];
+            if (m_curNode >= 0) return (m_curPattern = m_output[m_curNode]);
+        }
+    }
+
+
+    /** Find the next leftmost-longest occurrence of any pattern
+     *
+     * Among the matches that do not overlap the previously found one,
+     * the one starting at the lowest position is chosen; ties are resolved
+     * in favour of the longest match and then of the pattern that comes
+     * first in the dictionary.
+     *
+     * Cannot be mixed with findNext() between the calls to reset().
+     *
+     * @return the index of the matching pattern or -1 if there are
+     *    no more matches
+     */
+    R_len_t findNextLongest() {
+        R_len_t cand_start = -1, cand_end = -1, cand_pattern = -1;
+        while (m_searchPos < m_searchLen) {
+            m_state = getNextState(m_state, getNextSymbol());
+
+            // no match that has not been reported yet can start
+            // before the current state's prefix:
+            if (cand_pattern >= 0 && getPosBack(m_depth[m_state]) > cand_start)
+                break;
+
+            // the longest pattern ending here:
+            R_len_t node = (m_output[m_state] >= 0)?m_state:m_outputLink[m_state];
+            if (node >= 0) {
+                R_len_t start = getPosBack(m_depth[node]);
+                if (cand_pattern < 0 || start <= cand_start) {
+                    // matches are visited in the order of their end positions,
+                    // hence this one is not shorter than the candidate
+                    cand_start = start;
+                    cand_end = m_searchPos;
+                    cand_pattern = m_output[node];
+                }
+            }
+        }
+
+        if (cand_pattern < 0)
+            return -1;
+
+        // the next search starts right after the match
+        m_searchPos = cand_end;
+        m_state = 0;
+        m_curNode = -1;
+        return (m_curPattern = cand_pattern);
+    }
+
+
+    /** Get the length of the i-th pattern
+     *
+     * @return length in bytes (case-sensitive mode)
+     *    or in code points (case-insensitive mode)
+     */
+    inline R_len_t getPatternLength(R_len_t i) const {
+        return m_patternLen[i];
+    }
+
+
+    /** Get the end of the match found by the last call to findNext()
+     *
+     * @return byte index in searchStr
+     */
+    inline R_len_t getMatchedEnd() const {
+        return m_searchPos;
+    }
+
+
+    /** Get the start of the match found by the last call to findNext()
+     *
+     * @return byte index in searchStr
+     */
+    R_len_t getMatchedStart() const {
+#ifndef NDEBUG
+        if (m_curPattern < 0)
+            throw StriException("StriByteSearchDict: no match at current position! This is a BUG.");
+#endif
+        return getPosBack(m_patternLen[m_curPattern]);
+    }
+};
+
+
+#endif
@@ -40,6 +40,18 @@
 #define USEARCH_DONE -1
 #endif
 
+// #define STRI__BYTESEARCH_DISABLE_SIMD
+
+#if !defined(STRI__BYTESEARCH_DISABLE_SIMD) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define STRI__BYTESEARCH_SSE2
+#include <emmintrin.h>
+#if defined(__x86_64__)
+#define STRI__BYTESEARCH_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
 
 /**
  * Performs actual pattern matching on behalf of StriContainerByteSearch
@@ -529,4 +541,189 @@ public:
 };
 
 
+#ifdef STRI__BYTESEARCH_SSE2
+
+#define STRI__BYTESEARCH_SIMD_GIVE_UP -2
+
+// glibc's strstr() (see StriByteSearchMatcherShort) is already vectorised
+#ifdef __GLIBC__
+#define STRI__BYTESEARCH_SIMD_MINLEN 16
+#else
+#define STRI__BYTESEARCH_SIMD_MINLEN 2
+#endif
+
+
+/** Is the number of false positives of the first/last byte filter
+ *  large enough for us to better switch to KMP?
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+inline bool stri__bytesearch_simd_give_up(R_len_t fails, R_len_t scanned)
+{
+    return fails > 16+scanned/8;
+}
+
+
+/** Search for the first pattern occurrence starting at [i, last],
+ *  16 candidate positions at a time
+ *
+ * Candidates must match the first and the last byte of the pattern;
+ * these are only then compared byte by byte.
+ *
+ * @param s string to search in
+ * @param i [in/out] where to start; on return, the first position
+ *   that has not been examined yet (only meaningful if no match was found)
+ * @param last last admissible match start
+ * @param p pattern
+ * @param m pattern length (>= 2)
+ * @param from where the whole search started
+ * @param fails [in/out] number of false positives so far
+ * @return match start, USEARCH_DONE if there are fewer than 16 positions
+ *    left, or STRI__BYTESEARCH_SIMD_GIVE_UP
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+inline R_len_t stri__bytesearch_find_sse2(const char* s, R_len_t& i, R_len_t last,
+    const char* p, R_len_t m, R_len_t from, R_len_t& fails)
+{
+    const __m128i first = _mm_set1_epi8(p[0]);
+    const __m128i lastb = _mm_set1_epi8(p[m-1]);
+    while (i+15 <= last) {
+        __m128i block_first = _mm_loadu_si128((const __m128i*)(s+i));
+        __m128i block_final = _mm_loadu_si128((const __m128i*)(s+i+m-1));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(lastb, block_final)));
+        while (mask != 0) {
+            R_len_t k = (R_len_t)__builtin_ctz(mask);
+            if (memcmp(s+i+k+1, p+1, m-2) == 0)
+                return i+k;
+            ++fails;
+            mask &= mask-1;
+        }
+        i += 16;
+        if (stri__bytesearch_simd_give_up(fails, i-from))
+            return STRI__BYTESEARCH_SIMD_GIVE_UP;
+    }
+    return USEARCH_DONE;
+}
+
+
+#ifdef STRI__BYTESEARCH_AVX2
+/** Is AVX2 available at runtime?
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+inline bool stri__bytesearch_has_avx2()
+{
+    static const bool has_avx2 = (bool)__builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+
+/** Same as stri__bytesearch_find_sse2, but 32 candidate positions at a time
+ *
+ * Call only if stri__bytesearch_has_avx2()
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+__attribute__((target("avx2")))
+inline R_len_t stri__bytesearch_find_avx2(const char* s, R_len_t& i, R_len_t last,
+    const char* p, R_len_t m, R_len_t from, R_len_t& fails)
+{
+    const __m256i first = _mm256_set1_epi8(p[0]);
+    const __m256i lastb = _mm256_set1_epi8(p[m-1]);
+    while (i+31 <= last) {
+        __m256i block_first = _mm256_loadu_si256((const __m256i*)(s+i));
+        __m256i block_final = _mm256_loadu_si256((const __m256i*)(s+i+m-1));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(lastb, block_final)));
+        while (mask != 0) {
+            R_len_t k = (R_len_t)__builtin_ctz(mask);
+            if (memcmp(s+i+k+1, p+1, m-2) == 0)
+                return i+k;
+            ++fails;
+            mask &= mask-1;
+        }
+        i += 32;
+        if (stri__bytesearch_simd_give_up(fails, i-from))
+            return STRI__BYTESEARCH_SIMD_GIVE_UP;
+    }
+    return USEARCH_DONE;
+}
+#endif
+
+
+/**
+ * Case-sensitive search for patterns of length >= 2 using SIMD
+ * (SSE2, plus AVX2 if supported by the CPU) to filter the candidate
+ * positions that match the pattern's first and last byte.
+ *
+ * Falls back to KMP if the filter yields too many false positives
+ * (e.g., on highly repetitive text) so that the search time remains linear.
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriByteSearchMatcherSIMD : public StriByteSearchMatcherKMP {
+
+private:
+
+    StriByteSearchMatcherSIMD(const StriByteSearchMatcherSIMD&); /* no copy-able */
+    StriByteSearchMatcherSIMD& operator=(const StriByteSearchMatcherSIMD&);
+
+protected:
+
+    virtual R_len_t findFromPos(R_len_t startPos) {
+#ifndef NDEBUG
+        if (!m_searchStr) throw StriException("!m_searchStr");
+        if (m_kmpNext[0] <= -100) throw StriException("!NDEBUG: StriByteSearchMatcherSIMD: KMP table not ready");
+#endif
+
+        R_len_t last = m_searchLen-m_patternLen;
+        R_len_t i = startPos;
+        R_len_t fails = 0;
+        R_len_t res = USEARCH_DONE;
+
+#ifdef STRI__BYTESEARCH_AVX2
+        if (stri__bytesearch_has_avx2())
+            res = stri__bytesearch_find_avx2(m_searchStr, i, last, m_patternStr, m_patternLen, startPos, fails);
+        if (res == USEARCH_DONE)
+#endif
+            res = stri__bytesearch_find_sse2(m_searchStr, i, last, m_patternStr, m_patternLen, startPos, fails);
+
+        for (; res == USEARCH_DONE && i <= last; ++i) {  // the remaining < 16 positions
+            if (m_searchStr[i] == m_patternStr[0] && m_searchStr[i+m_patternLen-1] == m_patternStr[m_patternLen-1]
+                    && memcmp(m_searchStr+i+1, m_patternStr+1, m_patternLen-2) == 0)
+                res = i;
+        }
+
+        if (res == STRI__BYTESEARCH_SIMD_GIVE_UP)
+            return StriByteSearchMatcherKMP::findFromPos(i);
+
+        if (res == USEARCH_DONE) {
+            m_searchPos = m_searchEnd = m_searchLen;
+            return USEARCH_DONE;
+        }
+
+        m_searchPos = res;
+        m_searchEnd = res+m_patternLen;
+        return m_searchPos;
+    }
+
+public:
+
+    StriByteSearchMatcherSIMD(const char* patternStr, R_len_t patternLen, bool optOverlap)
+        : StriByteSearchMatcherKMP(patternStr, patternLen, optOverlap)
+    {
+#ifndef NDEBUG
+        if (patternLen < 2) throw StriException("StriByteSearchMatcherSIMD");
+#endif
+    }
+
+    // findFirst() and findLast() inherited from StriByteSearchMatcherKMP;
+    // the former calls our findFromPos() once the KMP table is ready
+};
+
+#endif
+
+
 #endif
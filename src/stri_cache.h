@@ -0,0 +1,233 @@
+/* This file is part of the 'stringi' project.
+ * Copyright (c) 2013-2026, Marek Gagolewski <https://www.gagolewski.com/>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __stri_cache_h
+#define __stri_cache_h
+
+#include "stri_stringi.h"
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+
+
+/**
+ * The interface shared by all the process-wide caches, through which
+ * they are managed by stri_options(), stri_info(), and R_unload_stringi()
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriCacheBase {
+
+public:
+
+    virtual ~StriCacheBase() { }
+
+    virtual void clear() = 0;
+
+    virtual R_len_t getCapacity() const = 0;
+
+    /** 0 disables the cache */
+    virtual void setCapacity(R_len_t _capacity) = 0;
+
+    /** cache statistics as a named numeric vector, see stri_info() */
+    virtual SEXP getInfo() const = 0;
+};
+
+
+/**
+ * A bounded, process-wide least-recently-used cache of ICU objects
+ * that are expensive to construct (compiled regexes and the like)
+ *
+ * The cache owns the stored values: they are disposed of with
+ * \code{Deleter()(value)} upon eviction, on \code{clear()},
+ * and in the destructor. The values returned by \code{get()} are
+ * only borrowed: they may be invalidated by the next call to \code{put()},
+ * hence the callers should clone them if they need them for longer.
+ *
+ * No locking is performed: R is single-threaded; code run
+ * by stri__parallel_for() must guard the accesses itself
+ * (with an OpenMP critical section).
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+template <class Key, class Value, class Deleter>
+class StriLRUCache : public StriCacheBase {
+
+private:
+
+    typedef std::list< std::pair<Key, Value> > StriLRUCacheList;
+    typedef std::map< Key, typename StriLRUCacheList::iterator > StriLRUCacheIndex;
+
+    StriLRUCacheList items;  ///< most recently used first
+    StriLRUCacheIndex index; ///< key -> position in items
+    R_len_t capacity;        ///< max number of items stored; 0 disables the cache
+    double hits;             ///< number of successful lookups
+    double misses;           ///< number of unsuccessful lookups
+
+    StriLRUCache(const StriLRUCache&); /* not copy-able */
+    StriLRUCache& operator=(const StriLRUCache&);
+
+    void shrink(R_len_t newsize) {
+        while ((R_len_t)items.size() > newsize) {
+            Deleter()(items.back().second);
+            index.erase(items.back().first);
+            items.pop_back();
+        }
+    }
+
+public:
+
+    StriLRUCache(R_len_t _capacity)
+        : capacity(_capacity), hits(0.0), misses(0.0)
+    { }
+
+    virtual ~StriLRUCache() {
+        shrink(0);
+    }
+
+    /** get the item associated with a given key (borrowed),
+     *  or NULL if there is none
+     */
+    Value get(const Key& key) {
+        typename StriLRUCacheIndex::iterator it = index.find(key);
+        if (it == index.end()) {
+            ++misses;
+            return NULL;
+        }
+
+        ++hits;
+        items.splice(items.begin(), items, it->second); // move to front
+        return it->second->second;
+    }
+
+    /** store a new item (ownership is transferred to the cache)
+     *
+     *  if the cache is disabled, the value is disposed of immediately
+     *  and NULL is returned; otherwise, the value is returned back (borrowed)
+     */
+    Value put(const Key& key, Value value) {
+        if (capacity <= 0) {
+            Deleter()(value);
+            return NULL;
+        }
+
+        typename StriLRUCacheIndex::iterator it = index.find(key);
+        if (it != index.end()) {
+            // should not happen if get() is called beforehand, but still
+            Deleter()(it->second->second);
+            items.erase(it->second);
+            index.erase(it);
+        }
+
+        shrink(capacity-1);
+        items.push_front(std::make_pair(key, value));
+        index[key] = items.begin();
+        return value;
+    }
+
+    virtual void clear() {
+        shrink(0);
+    }
+
+    void resetCounters() {
+        hits = misses = 0.0;
+    }
+
+    virtual R_len_t getCapacity() const {
+        return capacity;
+    }
+
+    virtual void setCapacity(R_len_t _capacity) {
+        STRI_ASSERT(_capacity >= 0);
+        capacity = _capacity;
+        shrink(capacity);
+    }
+
+    R_len_t getSize() const {
+        return (R_len_t)items.size();
+    }
+
+    double getHits() const {
+        return hits;
+    }
+
+    double getMisses() const {
+        return misses;
+    }
+
+    virtual SEXP getInfo() const {
+        SEXP ret;
+        PROTECT(ret = Rf_allocVector(REALSXP, 4));
+        REAL(ret)[0] = (double)getSize();
+        REAL(ret)[1] = (double)getCapacity();
+        REAL(ret)[2] = getHits();
+        REAL(ret)[3] = getMisses();
+        stri__set_names(ret, 4, "size", "capacity", "hits", "misses");
+        UNPROTECT(1);
+        return ret;
+    }
+};
+
+
+/**
+ * An item of the conversion cache: the UTF-8 and/or UTF-16 representation
+ * of a Latin-1 or natively-encoded (but not UTF-8) CHARSXP,
+ * as determined by StriContainerUTF8 and StriContainerUTF16, respectively
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriConversionCacheEntry {
+    R_len_t slot;        ///< where the source CHARSXP is protected, see stri_container_base.cpp
+    bool has_utf8;
+    std::string utf8;
+    UnicodeString utf16; ///< bogus if not set
+
+    StriConversionCacheEntry(R_len_t _slot) : slot(_slot), has_utf8(false) {
+        utf16.setToBogus();
+    }
+};
+
+
+// container_base.cpp:
+StriConversionCacheEntry* stri__conversion_cache_get(SEXP curs);
+StriConversionCacheEntry* stri__conversion_cache_put(SEXP curs);
+
+
+// the process-wide caches, registered in stri__options (ICU_settings.cpp):
+extern StriCacheBase& stri__regex_pattern_cache_base;    // container_regex.cpp
+extern StriCacheBase& stri__transliterator_cache_base;   // trans_transliterate.cpp
+extern StriCacheBase& stri__collator_cache_base;         // collator.cpp
+extern StriCacheBase& stri__conversion_cache_base;       // container_base.cpp
+extern StriCacheBase& stri__brkiter_cache_base;          // brkiter.cpp
+
+#endif
@@ -31,8 +31,106 @@
 
 
 #include "stri_stringi.h"
+#include "stri_cache.h"
 #include <unicode/ucol.h>
 #include <unicode/usearch.h>
+#include <string>
+
+
+/** Default capacity of the collator cache,
+ *  see stri_options(collator_cache_size=...)
+ */
+#define STRI__COLLATOR_CACHE_SIZE_DEFAULT 32
+
+
+/** Number of collator attributes that are a part of a cache key */
+#define STRI__COLLATOR_CACHE_NUMATTRIBS 7
+
+
+/** A key to the collator cache: the locale and the attribute values
+ *  as determined by stri__ucol_open
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriCollatorCacheKey {
+    std::string locale;
+    UColAttributeValue attribs[STRI__COLLATOR_CACHE_NUMATTRIBS];
+
+    bool operator<(const StriCollatorCacheKey& other) const {
+        for (int i=0; i<STRI__COLLATOR_CACHE_NUMATTRIBS; ++i) {
+            if (attribs[i] != other.attribs[i])
+                return attribs[i] < other.attribs[i];
+        }
+        return locale < other.locale;
+    }
+};
+
+
+/** An item of the collator cache: a prototype to be cloned
+ *  and the (warning) status returned when it was opened
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriCollatorCacheEntry {
+    UCollator* collator;
+    UErrorCode status;
+
+    StriCollatorCacheEntry(UCollator* _collator, UErrorCode _status)
+        : collator(_collator), status(_status) { }
+};
+
+
+struct StriCollatorDeleter {
+    void operator()(StriCollatorCacheEntry* entry) const {
+        ucol_close(entry->collator);
+        delete entry;
+    }
+};
+
+
+/** Configured collators shared by all the functions that call stri__ucol_open */
+static StriLRUCache<StriCollatorCacheKey, StriCollatorCacheEntry*, StriCollatorDeleter>
+    stri__collator_cache(STRI__COLLATOR_CACHE_SIZE_DEFAULT);
+
+StriCacheBase& stri__collator_cache_base = stri__collator_cache;
+
+
+/** Clone a collator
+ *
+ * @param col collator
+ * @param status [out] ICU error code
+ * @return a new collator that should be closed with ucol_close() after use
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static UCollator* stri__ucol_clone(const UCollator* col, UErrorCode* status)
+{
+#if U_ICU_VERSION_MAJOR_NUM>=71
+    return ucol_clone(col, status);
+#else
+    return ucol_safeClone(col, NULL, NULL, status);
+#endif
+}
+
+
+/** Warn if the collator falls back to the root locale (#476)
+ *
+ * @param col collator
+ * @param status the status returned by ucol_open()
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    separated from stri__ucol_open
+ */
+static void stri__ucol_warn_root_fallback(const UCollator* col, UErrorCode status)
+{
+    if (status != U_USING_DEFAULT_WARNING)
+        return;
+
+    UErrorCode status2 = U_ZERO_ERROR;
+    const char* valid_locale = ucol_getLocaleByType(col, ULOC_VALID_LOCALE, &status2);
+    if (valid_locale && !strcmp(valid_locale, "root"))
+        Rf_warning("%s", ICUError::getICUerrorName(status));
+}
 
 
 /**
@@ -68,6 +166,10 @@
  *
  * @version 1.8.1 (Marek Gagolewski, 2023-11-07)
  *    #476: Warn when falling back to the root locale, make C==en_US_POSIX
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    clone the collators kept in a process-wide cache,
+ *    see stri_options(collator_cache_size=...)
  */
 UCollator* stri__ucol_open(SEXP opts_collator)
 {
@@ -78,17 +180,6 @@ UCollator* stri__ucol_open(SEXP opts_collator)
 
     const char* default_locale = stri__prepare_arg_locale(R_NilValue, "locale");
 
-    if (narg <= 0) { // no custom settings - use default Collator
-        UErrorCode status = U_ZERO_ERROR;
-        UCollator* col = ucol_open(default_locale, &status);
-        STRI__CHECKICUSTATUS_RFERROR(status, {/* do nothing special on err */}) // error() allowed here
-        return col;
-    }
-
-    SEXP names = PROTECT(Rf_getAttrib(opts_collator, R_NamesSymbol));
-    if (names == R_NilValue || LENGTH(names) != narg)
-        Rf_error(MSG__INCORRECT_COLLATOR_OPTION_SPEC); // error() allowed here
-
     /* First, let's fetch collator's options --
     this process may call Rf_error, so we cannot do uloc_open yet (memleaks!) */
     UColAttributeValue  opt_FRENCH_COLLATION = UCOL_DEFAULT;
@@ -101,6 +192,14 @@ UCollator* stri__ucol_open(SEXP opts_collator)
 //   USearchAttributeValue  opt_OVERLAP = USEARCH_OFF;
     const char*         opt_LOCALE = default_locale;
 
+    SEXP names = R_NilValue;
+    if (narg > 0) { // otherwise, no custom settings - use default Collator
+        names = Rf_getAttrib(opts_collator, R_NamesSymbol);
+        if (names == R_NilValue || LENGTH(names) != narg)
+            Rf_error(MSG__INCORRECT_COLLATOR_OPTION_SPEC); // error() allowed here
+    }
+    PROTECT(names);
+
     for (R_len_t i=0; i<narg; ++i) {
         if (STRING_ELT(names, i) == NA_STRING)
             Rf_error(MSG__INCORRECT_COLLATOR_OPTION_SPEC); // error() allowed here
@@ -149,17 +248,36 @@ UCollator* stri__ucol_open(SEXP opts_collator)
     }
     UNPROTECT(1); /* names */
 
-    // create collator
+    // reuse a cached collator with the same settings, if available
+    StriCollatorCacheKey key;
+    key.locale = opt_LOCALE?opt_LOCALE:"";  // never NULL here anyway
+    key.attribs[0] = opt_STRENGTH;
+    key.attribs[1] = opt_FRENCH_COLLATION;
+    key.attribs[2] = opt_ALTERNATE_HANDLING;
+    key.attribs[3] = opt_CASE_FIRST;
+    key.attribs[4] = opt_CASE_LEVEL;
+    key.attribs[5] = opt_NORMALIZATION_MODE;
+    key.attribs[6] = opt_NUMERIC_COLLATION;
+
     UErrorCode status = U_ZERO_ERROR;
+    StriCollatorCacheEntry* cached = stri__collator_cache.get(key);
+    if (cached) {
+        // the same warning as if the collator was opened anew
+        if (narg > 0 && opt_LOCALE)
+            stri__ucol_warn_root_fallback(cached->collator, cached->status);
+
+        UCollator* col = stri__ucol_clone(cached->collator, &status);
+        STRI__CHECKICUSTATUS_RFERROR(status, { if (col) ucol_close(col); }) // error() allowed here
+        return col;
+    }
+
+    // create collator
     UCollator* col = ucol_open(opt_LOCALE, &status);
     STRI__CHECKICUSTATUS_RFERROR(status, { /* nothing special on err */ }) // error() allowed here
+    UErrorCode open_status = status;
 
-    if (status == U_USING_DEFAULT_WARNING && opt_LOCALE) {
-        UErrorCode status2 = U_ZERO_ERROR;
-        const char* valid_locale = ucol_getLocaleByType(col, ULOC_VALID_LOCALE, &status2);
-        if (valid_locale && !strcmp(valid_locale, "root"))
-            Rf_warning("%s", ICUError::getICUerrorName(status));
-    }
+    if (narg > 0 && opt_LOCALE)
+        stri__ucol_warn_root_fallback(col, open_status);
     // else if (status == U_USING_FALLBACK_WARNING)  // warning on this would be too invasive
     //    Rf_warning("%s", ICUError::getICUerrorName(status));
 
@@ -213,5 +331,12 @@ UCollator* stri__ucol_open(SEXP opts_collator)
         STRI__CHECKICUSTATUS_RFERROR(status, { ucol_close(col); }) // error() allowed here
     }
 
-    return col;
+    if (stri__collator_cache.getCapacity() <= 0)
+        return col;
+
+    status = U_ZERO_ERROR;
+    UCollator* ret = stri__ucol_clone(col, &status);
+    stri__collator_cache.put(key, new StriCollatorCacheEntry(col, open_status));  // now owned by the cache
+    STRI__CHECKICUSTATUS_RFERROR(status, { if (ret) ucol_close(ret); }) // error() allowed here
+    return ret;
 }
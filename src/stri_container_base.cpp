@@ -32,6 +32,141 @@
 
 #include "stri_stringi.h"
 #include "stri_container_base.h"
+#include "stri_cache.h"
+#include <vector>
+
+
+/** Default capacity of the conversion cache,
+ *  see stri_options(conversion_cache_size=...); disabled by default
+ */
+#define STRI__CONVERSION_CACHE_SIZE_DEFAULT 0
+
+
+/**
+ * The CHARSXPs that are keys in the conversion cache are kept alive
+ * (so that their addresses are not reused for other strings)
+ * by storing them in a list that is protected from garbage collection.
+ * R does not allow weak references to CHARSXPs; hence, the bounded
+ * cache capacity is what limits the memory held this way.
+ */
+static SEXP stri__conversion_cache_pool = NULL;         // a preserved VECSXP
+static std::vector<R_len_t> stri__conversion_cache_free; // unused slots in the pool
+
+
+/** Store a CHARSXP in the pool
+ *
+ * @param curs CHARSXP
+ * @return slot index
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static R_len_t stri__conversion_cache_pool_acquire(SEXP curs)
+{
+    if (stri__conversion_cache_free.empty()) {
+        R_len_t oldsize = stri__conversion_cache_pool?LENGTH(stri__conversion_cache_pool):0;
+        R_len_t newsize = (oldsize < 16)?16:2*oldsize;
+        SEXP pool;
+        PROTECT(pool = Rf_allocVector(VECSXP, newsize));
+        for (R_len_t i=0; i<oldsize; ++i)
+            SET_VECTOR_ELT(pool, i, VECTOR_ELT(stri__conversion_cache_pool, i));
+        R_PreserveObject(pool);
+        if (stri__conversion_cache_pool)
+            R_ReleaseObject(stri__conversion_cache_pool);
+        stri__conversion_cache_pool = pool;
+        UNPROTECT(1);
+
+        for (R_len_t i=newsize-1; i>=oldsize; --i)
+            stri__conversion_cache_free.push_back(i);
+    }
+
+    R_len_t slot = stri__conversion_cache_free.back();
+    stri__conversion_cache_free.pop_back();
+    SET_VECTOR_ELT(stri__conversion_cache_pool, slot, curs);
+    return slot;
+}
+
+
+struct StriConversionCacheDeleter {
+    void operator()(StriConversionCacheEntry* entry) const {
+        if (stri__conversion_cache_pool) {
+            SET_VECTOR_ELT(stri__conversion_cache_pool, entry->slot, R_NilValue);
+            stri__conversion_cache_free.push_back(entry->slot);
+        }
+        delete entry;
+    }
+};
+
+
+/** The conversion cache; clear() also releases the protection pool
+ *
+ * The destructor, run at process exit if the DLL has not been unloaded,
+ * does not touch the pool: R may have been shut down by then.
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriConversionCache
+    : public StriLRUCache<SEXP, StriConversionCacheEntry*, StriConversionCacheDeleter> {
+
+public:
+
+    StriConversionCache(R_len_t _capacity)
+        : StriLRUCache<SEXP, StriConversionCacheEntry*, StriConversionCacheDeleter>(_capacity)
+    { }
+
+    virtual ~StriConversionCache() {
+        // the base class destructor disposes of the items; no R API calls then
+        stri__conversion_cache_pool = NULL;
+    }
+
+    virtual void clear() {
+        StriLRUCache<SEXP, StriConversionCacheEntry*, StriConversionCacheDeleter>::clear();
+        if (stri__conversion_cache_pool) {
+            R_ReleaseObject(stri__conversion_cache_pool);
+            stri__conversion_cache_pool = NULL;
+        }
+        stri__conversion_cache_free.clear();
+    }
+};
+
+
+/** Converted strings shared by StriContainerUTF8 and StriContainerUTF16 */
+static StriConversionCache stri__conversion_cache(STRI__CONVERSION_CACHE_SIZE_DEFAULT);
+
+StriCacheBase& stri__conversion_cache_base = stri__conversion_cache;
+
+
+/** Get the cached conversions of a CHARSXP
+ *
+ * @param curs a Latin-1 or natively-encoded CHARSXP
+ * @return borrowed pointer (valid until the next call to
+ *    stri__conversion_cache_put) or NULL if not found
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+StriConversionCacheEntry* stri__conversion_cache_get(SEXP curs)
+{
+    if (stri__conversion_cache.getCapacity() <= 0)
+        return NULL;
+    return stri__conversion_cache.get(curs);
+}
+
+
+/** Add a new (empty) item to the conversion cache
+ *
+ * @param curs a Latin-1 or natively-encoded CHARSXP
+ * @return borrowed pointer (valid until the next call to
+ *    stri__conversion_cache_put) or NULL if the cache is disabled;
+ *    the caller should fill in the fields
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+StriConversionCacheEntry* stri__conversion_cache_put(SEXP curs)
+{
+    if (stri__conversion_cache.getCapacity() <= 0)
+        return NULL;
+    R_len_t slot = stri__conversion_cache_pool_acquire(curs);
+    return stri__conversion_cache.put(curs, new StriConversionCacheEntry(slot));
+}
 
 
 /**
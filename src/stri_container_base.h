@@ -35,6 +35,9 @@
 
 #include "stri_external.h"
 #include "stri_exception.h"
+#include <vector>
+#include <utility>
+#include <unordered_map>
 
 
 
@@ -107,6 +110,136 @@ public:
         else
             return i;
     }
+
+    /** Loop over vectorized container - the k-th index visited,
+     *  k in [0, nrecycle); for loops that cannot go sequentially
+     *  (e.g., stri__parallel_for) but should visit the elements
+     *  in the same order as vectorize_next() does
+     *
+     * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+     */
+    inline R_len_t vectorize_get(R_len_t k) const {
+        STRI_ASSERT(n > 0 && n <= nrecycle && k >= 0 && k < nrecycle);
+        R_len_t m = nrecycle / n;  // each index in [0, r) is visited m+1 times,
+        R_len_t r = nrecycle % n;  // and in [r, n) - m times
+        if (k < r*(m+1))
+            return (k / (m+1)) + (k % (m+1))*n;
+        k -= r*(m+1);
+        return r + (k / m) + (k % m)*n;
+    }
+};
+
+
+/** A table of matchers, one per distinct pattern in a container
+ *
+ * Used by pattern containers so that each distinct pattern is prepared
+ * only once per call, even if the repeated patterns are not consecutive
+ * (e.g., in \code{stri_detect_fixed(x, rep(patterns, length.out=length(x)))}
+ * or if several patterns are recycled over a longer vector).
+ * Equal patterns are identified up front (via hashing).
+ * If each pattern is used exactly once, there is nothing to be reused;
+ * then only the most recently used matcher is kept, so that the memory use
+ * does not grow with the number of patterns.
+ *
+ * @tparam T pointer type
+ * @tparam Deleter \code{Deleter()(item)} disposes of an item
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+template <class T, class Deleter>
+class StriMatcherTable {
+
+private:
+
+    std::vector<R_len_t> ids; ///< ids[i] is the smallest j such that the j-th pattern equals the i-th one; empty if the table is not used
+    std::vector<T> items;     ///< items[ids[i]] is the matcher for the i-th pattern or NULL
+    R_len_t lastIndex;        ///< index of the pattern the last matcher was created for (if ids is empty)
+    T last;                   ///< the last matcher (if ids is empty)
+
+    StriMatcherTable(const StriMatcherTable&); // not copyable
+    StriMatcherTable& operator=(const StriMatcherTable&);
+
+public:
+
+    StriMatcherTable() : lastIndex(-1), last(NULL) { }
+
+    ~StriMatcherTable() { clear(); }
+
+    /** Identify the equal patterns
+     *
+     * @param n number of patterns
+     * @param nrecycle vectorisation length
+     * @param hash \code{hash(i)} gives a hash of the i-th pattern
+     * @param equal \code{equal(i, j)} compares the i-th and the j-th pattern
+     */
+    template <class Hash, class Equal>
+    void init(R_len_t n, R_len_t nrecycle, const Hash& hash, const Equal& equal) {
+        clear();
+        ids.clear();
+        items.clear();
+        if (n <= 0 || nrecycle <= 1) return;
+
+        typedef std::unordered_map<R_len_t, R_len_t, Hash, Equal> StriMatcherIdsMap;
+        std::vector<R_len_t> first(n);
+        StriMatcherIdsMap seen(n, hash, equal);
+        for (R_len_t i=0; i<n; ++i)
+            first[i] = seen.insert(std::make_pair(i, i)).first->second;
+
+        if ((R_len_t)seen.size() >= nrecycle)
+            return;  // each pattern is used exactly once
+
+        ids.swap(first);
+        items.assign(n, (T)NULL);
+    }
+
+    /** Reuse the pattern ids determined for another container
+     *  with the same patterns (the matchers are not copied) */
+    void init(const StriMatcherTable& other) {
+        clear();
+        ids = other.ids;
+        items.assign(ids.size(), (T)NULL);
+    }
+
+    /** Dispose of all the matchers */
+    void clear() {
+        Deleter deleter;
+        for (size_t j=0; j<items.size(); ++j) {
+            if (items[j]) {
+                deleter(items[j]);
+                items[j] = NULL;
+            }
+        }
+        if (last) {
+            deleter(last);
+            last = NULL;
+        }
+        lastIndex = -1;
+    }
+
+    /** Equal patterns share the same id, i in [0, n) */
+    inline R_len_t getId(R_len_t i) const {
+        return ids.empty()?i:ids[i];
+    }
+
+    /** The matcher for the i-th pattern, i in [0, n), or NULL if there is none */
+    inline T get(R_len_t i) const {
+        if (ids.empty()) return (lastIndex == i)?last:NULL;
+        return items[ids[i]];
+    }
+
+    /** Store a new matcher for the i-th pattern, i in [0, n),
+     *  taking over its ownership */
+    void set(R_len_t i, T item) {
+        if (ids.empty()) {
+            if (last) Deleter()(last);
+            last = item;
+            lastIndex = i;
+        }
+        else {
+            STRI_ASSERT(!items[ids[i]]);
+            items[ids[i]] = item;
+        }
+    }
 };
 
 #endif
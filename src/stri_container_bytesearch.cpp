@@ -35,6 +35,38 @@
 #include <unicode/usearch.h>
 
 
+/** Hashes and compares the patterns in a container byte-wise;
+ *  see StriMatcherTable::init()
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriContainerByteSearchHash {
+    const StriContainerUTF8* cont;
+
+    StriContainerByteSearchHash(const StriContainerUTF8* _cont) : cont(_cont) { }
+
+    size_t operator()(R_len_t i) const {
+        if (cont->isNA(i)) return 0;
+        const String8& s = cont->get(i);
+        const char* p = s.c_str();
+        size_t h = 2166136261u;  // FNV-1a
+        for (R_len_t j=0; j<s.length(); ++j) {
+            h ^= (size_t)(uint8_t)p[j];
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    bool operator()(R_len_t i, R_len_t j) const {
+        if (cont->isNA(i) || cont->isNA(j)) return cont->isNA(i) && cont->isNA(j);
+        const String8& a = cont->get(i);
+        const String8& b = cont->get(j);
+        return a.length() == b.length() &&
+            memcmp(a.c_str(), b.c_str(), (size_t)a.length()) == 0;
+    }
+};
+
+
 /**
  * Default constructor
  *
@@ -42,7 +74,6 @@
 StriContainerByteSearch::StriContainerByteSearch()
     : StriContainerUTF8()
 {
-    this->matcher = NULL;
     this->flags = 0;
 }
 
@@ -56,7 +87,6 @@ StriContainerByteSearch::StriContainerByteSearch(SEXP rstr, R_len_t _nrecycle, u
     : StriContainerUTF8(rstr, _nrecycle, true)
 {
     this->flags = _flags;
-    this->matcher = NULL;
 
     R_len_t n = get_n();
     for (R_len_t i=0; i<n; ++i) {
@@ -64,6 +94,9 @@ StriContainerByteSearch::StriContainerByteSearch(SEXP rstr, R_len_t _nrecycle, u
             Rf_warning(MSG__EMPTY_SEARCH_PATTERN_UNSUPPORTED);
         }
     }
+
+    StriContainerByteSearchHash hash(this);
+    matchers.init(n, get_nrecycle(), hash, hash);
 }
 
 
@@ -73,8 +106,8 @@ StriContainerByteSearch::StriContainerByteSearch(SEXP rstr, R_len_t _nrecycle, u
 StriContainerByteSearch::StriContainerByteSearch(StriContainerByteSearch& container)
     :    StriContainerUTF8((StriContainerUTF8&)container)
 {
-    this->matcher = NULL;
     this->flags = container.flags;
+    this->matchers.init(container.matchers);
 }
 
 
@@ -84,8 +117,9 @@ StriContainerByteSearch::StriContainerByteSearch(StriContainerByteSearch& contai
  */
 StriContainerByteSearch& StriContainerByteSearch::operator=(StriContainerByteSearch& container)
 {
-    this->~StriContainerByteSearch();
     (StriContainerUTF8&) (*this) = (StriContainerUTF8&)container;
+    this->flags = container.flags;
+    this->matchers.init(container.matchers);
     return *this;
 }
 
@@ -95,36 +129,55 @@ StriContainerByteSearch& StriContainerByteSearch::operator=(StriContainerByteSea
  */
 StriContainerByteSearch::~StriContainerByteSearch()
 {
-    if (matcher) {
-        delete matcher;
-        matcher = NULL;
-    }
+    // matchers are disposed of by StriMatcherTable
 }
 
 
-/**
+/** Create a new matcher for the i-th pattern
+ *
+ * @param i index
+ * @return a new object, owned by the caller
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    separated from getMatcher(); use StriByteSearchMatcherSIMD
+ *    for longer case-sensitive patterns if available
+ */
+StriByteSearchMatcher* StriContainerByteSearch::createMatcher(R_len_t i)
+{
+    if (isCaseInsensitive())
+        return new StriByteSearchMatcherKMPci(get(i).c_str(), get(i).length(), isOverlap());
+    else if (get(i).length() == 1)
+        return new StriByteSearchMatcher1(get(i).c_str(), get(i).length(), isOverlap());
+#ifdef STRI__BYTESEARCH_SSE2
+    else if (get(i).length() >= STRI__BYTESEARCH_SIMD_MINLEN)
+        return new StriByteSearchMatcherSIMD(get(i).c_str(), get(i).length(), isOverlap());
+#endif
+    else if (get(i).length() < 16)
+        return new StriByteSearchMatcherShort(get(i).c_str(), get(i).length(), isOverlap());
+    else
+        return new StriByteSearchMatcherKMP(get(i).c_str(), get(i).length(), isOverlap());
+}
+
+
+/** The returned matcher shall not be deleted by the user
+ *
+ * it is assumed that vectorize_next() is used:
+ * for i >= this->n the last matcher is returned
+ *
+ * @param i index
+ *
  * @version 0.5-1 (Marek Gagolewski, 2015-02-14)
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    each distinct pattern gets its own matcher, which is reused
+ *    throughout the whole call
  */
 StriByteSearchMatcher* StriContainerByteSearch::getMatcher(R_len_t i) {
-    if (i >= n && matcher && matcher->getPatternStr() == get(i).c_str()) {
-        // matcher reuse
+    StriByteSearchMatcher* matcher = matchers.get(i % n);
+    if (!matcher) {
+        matcher = createMatcher(i);
+        matchers.set(i % n, matcher);
     }
-    else {
-        if (matcher) {
-            delete matcher;
-            matcher = NULL;
-        }
-
-        if (isCaseInsensitive())
-            matcher = new StriByteSearchMatcherKMPci(get(i).c_str(), get(i).length(), isOverlap());
-        else if (get(i).length() == 1)
-            matcher = new StriByteSearchMatcher1(get(i).c_str(), get(i).length(), isOverlap());
-        else if (get(i).length() < 16)
-            matcher = new StriByteSearchMatcherShort(get(i).c_str(), get(i).length(), isOverlap());
-        else
-            matcher = new StriByteSearchMatcherKMP(get(i).c_str(), get(i).length(), isOverlap());
-    }
-
     return matcher;
 }
 
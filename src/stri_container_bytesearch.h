@@ -67,19 +67,30 @@
  *
  * @version 1.3.1 (Marek Gagolewski, 2019-02-06)
  *          #337: warn on empty search pattern here
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *          keep one matcher per distinct pattern
  */
 class StriContainerByteSearch : public StriContainerUTF8 {
 
-private:
+public:
 
     typedef enum ByteSearchFlag {
         BYTESEARCH_CASE_INSENSITIVE = 2,
         BYTESEARCH_OVERLAP = 4
     } ByteSearchFlag;
 
-    StriByteSearchMatcher* matcher;
+private:
+
+    struct MatcherDeleter {
+        void operator()(StriByteSearchMatcher* matcher) const { delete matcher; }
+    };
+
+    StriMatcherTable<StriByteSearchMatcher*, MatcherDeleter> matchers; ///< one per distinct pattern
     uint32_t flags; ///< ByteSearch flags
 
+    StriByteSearchMatcher* createMatcher(R_len_t i);
+
 
 public:
 
@@ -32,6 +32,25 @@
 
 #include "stri_stringi.h"
 #include "stri_container_regex.h"
+#include "stri_cache.h"
+
+
+/** Default capacity of the compiled regex pattern cache,
+ *  see stri_options(regex_cache_size=...)
+ */
+#define STRI__REGEX_CACHE_SIZE_DEFAULT 256
+
+
+struct StriRegexPatternDeleter {
+    void operator()(RegexPattern* p) const { delete p; }
+};
+
+
+/** Compiled regex patterns shared by all the stri_*_regex calls */
+static StriLRUCache<StriRegexPatternCacheKey, RegexPattern*, StriRegexPatternDeleter>
+    stri__regex_pattern_cache(STRI__REGEX_CACHE_SIZE_DEFAULT);
+
+StriCacheBase& stri__regex_pattern_cache_base = stri__regex_pattern_cache;
 
 
 /**
@@ -70,6 +89,9 @@ StriContainerRegexPattern::StriContainerRegexPattern(SEXP rstr, R_len_t _nrecycl
             Rf_warning(MSG__EMPTY_SEARCH_PATTERN_UNSUPPORTED);
         }
     }
+
+    StriContainerUTF16Hash hash(this);
+    matchers.init(n, get_nrecycle(), hash, hash);
 }
 
 
@@ -84,18 +106,19 @@ StriContainerRegexPattern::StriContainerRegexPattern(StriContainerRegexPattern&
     this->lastCaptureGroupNamesIndex = -1;
     //this->lastCaptureGroupNames = ...
     this->opts = container.opts;
+    this->matchers.init(container.matchers);
 }
 
 
 StriContainerRegexPattern& StriContainerRegexPattern::operator=(StriContainerRegexPattern& container)
 {
-    this->~StriContainerRegexPattern();
     (StriContainerUTF16&) (*this) = (StriContainerUTF16&)container;
     this->lastMatcherIndex = -1;
     this->lastMatcher = NULL;
     this->lastCaptureGroupNamesIndex = -1;
     //this->lastCaptureGroupNames = ...
     this->opts = container.opts;
+    this->matchers.init(container.matchers);
     return *this;
 }
 
@@ -105,10 +128,8 @@ StriContainerRegexPattern& StriContainerRegexPattern::operator=(StriContainerReg
  */
 StriContainerRegexPattern::~StriContainerRegexPattern()
 {
-    if (lastMatcher) {
-        delete lastMatcher;
-        lastMatcher = NULL;
-    }
+    // matchers are disposed of by StriMatcherTable
+    lastMatcher = NULL;
 }
 
 
@@ -233,13 +254,14 @@ const std::vector<std::string>& StriContainerRegexPattern::getCaptureGroupNames(
     STRI_ASSERT(!this->isNA(i));
     STRI_ASSERT(this->get(i).length() > 0);
 
-    if (this->lastCaptureGroupNamesIndex == (i % n)) {
+    R_len_t id = matchers.getId(i % n);  // equal patterns share the same id
+    if (this->lastCaptureGroupNamesIndex == id) {
         return lastCaptureGroupNames; // reuse
     }
 
     int ngroups = lastMatcher->groupCount();
     lastCaptureGroupNames = std::vector<std::string>(ngroups);
-    this->lastCaptureGroupNamesIndex = (i % n);
+    this->lastCaptureGroupNamesIndex = id;
 
 
     if (ngroups == 0) return lastCaptureGroupNames;  // nothing to do
@@ -335,25 +357,47 @@ const std::vector<std::string>& StriContainerRegexPattern::getCaptureGroupNames(
  * for i >= this->n the last matcher is returned
  *
  * @param i index
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    use the compiled pattern cache;
+ *    each distinct pattern gets its own matcher, which is reused
+ *    throughout the whole call
  */
 RegexMatcher* StriContainerRegexPattern::getMatcher(R_len_t i)
 {
-    if (lastMatcher) {
-        if (this->lastMatcherIndex >= 0 && this->lastMatcherIndex == (i % n)) {
-            return lastMatcher; // reuse
-        }
-        else {
-            delete lastMatcher; // invalidate
-            this->lastMatcher = NULL;
-        }
+    if (lastMatcher && this->lastMatcherIndex >= 0 && this->lastMatcherIndex == (i % n)) {
+        return lastMatcher; // reuse
+    }
+
+    RegexMatcher* matcher = matchers.get(i % n);
+    if (!matcher) {
+        matcher = createMatcher(i);
+        matchers.set(i % n, matcher);
     }
 
+    this->lastMatcher = matcher;
+    this->lastMatcherIndex = (i % n);
+
+    return lastMatcher;
+}
+
+
+/** Create a new matcher for the i-th pattern
+ *
+ * @param i index
+ * @return a new matcher, owned by the caller, together with
+ *    the pattern it uses, see StriRegexMatcherDeleter
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    separated from getMatcher()
+ */
+RegexMatcher* StriContainerRegexPattern::createMatcher(R_len_t i)
+{
     UErrorCode status = U_ZERO_ERROR;
-    lastMatcher = new RegexMatcher(this->get(i), opts.flags, status);
+    RegexPattern* pattern = StriContainerRegexPattern::compilePattern(this->get(i), opts.flags, status);
 
     if (U_FAILURE(status)) {
-        if (lastMatcher) delete lastMatcher;
-        lastMatcher = NULL;
+        if (pattern) delete pattern;
 
         const char* context; // to ease debugging, #382
         std::string s;
@@ -367,22 +411,96 @@ RegexMatcher* StriContainerRegexPattern::getMatcher(R_len_t i)
         throw StriException(status, context);
     }
 
-    if (!lastMatcher) throw StriException(MSG__MEM_ALLOC_ERROR);
+    if (!pattern) throw StriException(MSG__MEM_ALLOC_ERROR);
+
+    RegexMatcher* matcher = pattern->matcher(status);
+    STRI__CHECKICUSTATUS_THROW(status, {
+        if (matcher) delete matcher;
+        delete pattern;
+    })
+
+    if (!matcher) {
+        delete pattern;
+        throw StriException(MSG__MEM_ALLOC_ERROR);
+    }
 
     if (opts.stack_limit > 0) {
-        lastMatcher->setStackLimit(opts.stack_limit, status);
-        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        matcher->setStackLimit(opts.stack_limit, status);
+        STRI__CHECKICUSTATUS_THROW(status, {StriRegexMatcherDeleter()(matcher);})
     }
 
     if (opts.time_limit > 0) {
-        lastMatcher->setTimeLimit(opts.time_limit, status);
-        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        matcher->setTimeLimit(opts.time_limit, status);
+        STRI__CHECKICUSTATUS_THROW(status, {StriRegexMatcherDeleter()(matcher);})
     }
 
+    return matcher;
+}
 
-    this->lastMatcherIndex = (i % n);
 
-    return lastMatcher;
+/** Get a compiled regex pattern, reusing the process-wide cache if possible
+ *
+ * Compiling a regex is much more expensive than copying an already
+ * compiled one; this matters when the same patterns are applied
+ * over and over again in many consecutive calls to stri_*_regex.
+ *
+ * @param pattern regex
+ * @param flags regex flags
+ * @param status [out] ICU error code
+ * @return a new RegexPattern object (owned by the caller) or NULL on error
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+RegexPattern* StriContainerRegexPattern::compilePattern(
+    const UnicodeString& pattern, uint32_t flags, UErrorCode& status
+) {
+    StriRegexPatternCacheKey key(pattern, flags);
+    RegexPattern* ret = NULL;
+    bool cached = false;
+
+    // may be called from within stri__parallel_for()
+#ifdef _OPENMP
+    #pragma omp critical(stri__regex_pattern_cache)
+#endif
+    {
+        RegexPattern* found = stri__regex_pattern_cache.get(key);
+        if (found) {
+            cached = true;
+            ret = found->clone();
+        }
+    }
+
+    if (cached) {
+        if (!ret) status = U_MEMORY_ALLOCATION_ERROR;
+        return ret;
+    }
+
+    RegexPattern* compiled = RegexPattern::compile(pattern, flags, status);
+    if (U_FAILURE(status)) {
+        // do not cache incorrect patterns
+        if (compiled) delete compiled;
+        return NULL;
+    }
+
+    if (!compiled) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+
+#ifdef _OPENMP
+    #pragma omp critical(stri__regex_pattern_cache)
+#endif
+    {
+        if (stri__regex_pattern_cache.getCapacity() <= 0)
+            ret = compiled;  // caching disabled
+        else {
+            ret = compiled->clone();
+            stri__regex_pattern_cache.put(key, compiled);  // now owned by the cache
+        }
+    }
+
+    if (!ret) status = U_MEMORY_ALLOCATION_ERROR;
+    return ret;
 }
 
 
@@ -475,3 +593,204 @@ StriRegexMatcherOptions StriContainerRegexPattern::getRegexOptions(SEXP opts_reg
     opts.stack_limit = stack_limit;
     return opts;
 }
+
+
+/** Move a pending literal to the list of the replacement's parts
+ *
+ * @param literal [in/out] cleared on return
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+void StriRegexReplacement::appendLiteral(UnicodeString& literal)
+{
+    if (literal.length() <= 0)
+        return;
+
+    std::string buf;
+    literal.toUTF8String(buf);  // combines escaped surrogate pairs
+    literals.push_back(buf);
+    groups.push_back(-1);
+    literal.remove();
+}
+
+
+/** A context for stri__regex_unescape_charAt
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriRegexUnescapeContext {
+    UText* text;
+    int32_t lastOffset;
+};
+
+
+/** A u_unescapeAt callback reading from a UText;
+ *  behaves exactly like ICU4C's (internal) uregex_utext_unescape_charAt
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static UChar U_CALLCONV stri__regex_unescape_charAt(int32_t offset, void* ct)
+{
+    StriRegexUnescapeContext* context = (StriRegexUnescapeContext*)ct;
+    UChar32 c;
+    if (offset == context->lastOffset + 1) {
+        c = UTEXT_NEXT32(context->text);
+        context->lastOffset++;
+    } else if (offset == context->lastOffset) {
+        c = UTEXT_PREVIOUS32(context->text);
+        UTEXT_NEXT32(context->text);
+    } else {
+        utext_moveIndex32(context->text, offset - context->lastOffset - 1);
+        c = UTEXT_NEXT32(context->text);
+        context->lastOffset = offset;
+    }
+
+    if (U_IS_BMP(c))
+        return (UChar)c;
+    else
+        return 0;
+}
+
+
+/** Parse a replacement string
+ *
+ * Follows RegexMatcher::appendReplacement (ICU4C 74) step by step,
+ * so that the results and the errors reported are the same
+ *
+ * @param replacement replacement string
+ * @param pattern the pattern the capture group names refer to
+ * @param ngroups the number of capture groups in the pattern
+ * @param status [out] U_INDEX_OUTOFBOUNDS_ERROR
+ *    or U_REGEX_INVALID_CAPTURE_GROUP_NAME on a malformed reference
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+void StriRegexReplacement::compile(
+    const UnicodeString& replacement, const RegexPattern& pattern,
+    int32_t ngroups, UErrorCode& status
+) {
+    literals.clear();
+    groups.clear();
+
+    UText* rtext = utext_openConstUnicodeString(NULL, &replacement, &status);
+    if (U_FAILURE(status))
+        return;
+
+    UnicodeString literal;
+    for (UChar32 c = UTEXT_NEXT32(rtext); U_SUCCESS(status) && c != U_SENTINEL; c = UTEXT_NEXT32(rtext)) {
+        if (c == 0x5c /* backslash */) {
+            c = UTEXT_CURRENT32(rtext);
+            if (c == U_SENTINEL)
+                break;
+
+            if (c == 0x55 /* U */ || c == 0x75 /* u */) {
+                int32_t offset = 0;
+                StriRegexUnescapeContext context = { rtext, -1 };
+                UChar32 escaped = u_unescapeAt(stri__regex_unescape_charAt, &offset, INT32_MAX, &context);
+                if (escaped != (UChar32)0xFFFFFFFF) {
+                    literal.append(escaped);
+                    if (context.lastOffset == offset)
+                        (void)UTEXT_PREVIOUS32(rtext);
+                    else if (context.lastOffset != offset-1)
+                        utext_moveIndex32(rtext, offset - context.lastOffset - 1);
+                }
+            }
+            else {
+                (void)UTEXT_NEXT32(rtext);
+                literal.append(c);
+            }
+        }
+        else if (c != 0x24 /* $ */) {
+            literal.append(c);
+        }
+        else {
+            // consume the digits as long as the group number is valid
+            int32_t group = 0;
+            int32_t ndigits = 0;
+            UChar32 next = UTEXT_CURRENT32(rtext);
+            if (next == 0x7b /* { */) {  // ${name}
+                UnicodeString name;
+                (void)UTEXT_NEXT32(rtext);
+                while (U_SUCCESS(status) && next != 0x7d /* } */) {
+                    next = UTEXT_NEXT32(rtext);
+                    if (next == U_SENTINEL) {
+                        status = U_REGEX_INVALID_CAPTURE_GROUP_NAME;
+                    }
+                    else if ((next >= 0x41 && next <= 0x5a) ||  // A..Z
+                            (next >= 0x61 && next <= 0x7a) ||   // a..z
+                            (next >= 0x31 && next <= 0x39)) {   // 1..9 (sic!)
+                        name.append(next);
+                    }
+                    else if (next == 0x7d /* } */) {
+                        UErrorCode name_status = U_ZERO_ERROR;
+                        group = pattern.groupNumberFromName(name, name_status);
+                        if (U_FAILURE(name_status) || group <= 0)
+                            status = U_REGEX_INVALID_CAPTURE_GROUP_NAME;
+                    }
+                    else {
+                        status = U_REGEX_INVALID_CAPTURE_GROUP_NAME;
+                    }
+                }
+            }
+            else if (u_isdigit(next)) {  // $n
+                while (true) {
+                    next = UTEXT_CURRENT32(rtext);
+                    if (next == U_SENTINEL || !u_isdigit(next))
+                        break;
+                    int32_t digit = u_charDigitValue(next);
+                    if (group*10 + digit > ngroups) {
+                        if (ndigits == 0)
+                            status = U_INDEX_OUTOFBOUNDS_ERROR;
+                        break;
+                    }
+                    (void)UTEXT_NEXT32(rtext);
+                    group = group*10 + digit;
+                    ++ndigits;
+                }
+            }
+            else {
+                status = U_REGEX_INVALID_CAPTURE_GROUP_NAME;
+            }
+
+            if (U_SUCCESS(status)) {
+                appendLiteral(literal);
+                literals.push_back(std::string());
+                groups.push_back(group);
+            }
+        }
+    }
+
+    utext_close(rtext);
+    appendLiteral(literal);
+}
+
+
+/** Append the replacement for the current match
+ *
+ * @param out [in/out] output buffer (UTF-8)
+ * @param str the UTF-8 string the matcher has been reset with (via UText),
+ *    so that the matcher's (native) indexes are byte offsets in str
+ * @param matcher a matcher at a successful match
+ * @param status [out]
+ * @param group_offset added to the capture group numbers, for a pattern
+ *    embedded in a larger one as a group (then, $0 refers to that group)
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+void StriRegexReplacement::append(
+    std::string& out, const char* str, RegexMatcher* matcher, UErrorCode& status,
+    int32_t group_offset
+) const {
+    for (size_t k=0; k<groups.size(); ++k) {
+        if (groups[k] < 0) {
+            out.append(literals[k]);
+            continue;
+        }
+
+        int32_t start = matcher->start(groups[k]+group_offset, status);
+        int32_t end = matcher->end(groups[k]+group_offset, status);
+        if (U_FAILURE(status)) return;
+        if (start >= 0)  // otherwise, the group was not part of the match
+            out.append(str+start, (size_t)(end-start));
+    }
+}
@@ -36,7 +36,7 @@
 
 #include <unicode/regex.h>
 #include <vector>
-#include <vector>
+#include <string>
 #include "stri_container_utf16.h"
 
 
@@ -52,6 +52,41 @@ struct StriRegexMatcherOptions {
 };
 
 
+/** A key to the compiled regex pattern cache;
+ *  the stack and time limits are RegexMatcher's settings,
+ *  therefore they do not influence the compiled pattern
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriRegexPatternCacheKey {
+    UnicodeString pattern;
+    uint32_t flags;
+
+    StriRegexPatternCacheKey(const UnicodeString& _pattern, uint32_t _flags)
+        : pattern(_pattern), flags(_flags) { }
+
+    bool operator<(const StriRegexPatternCacheKey& other) const {
+        if (flags != other.flags) return flags < other.flags;
+        return pattern < other.pattern;
+    }
+};
+
+
+
+/** Disposes of a RegexMatcher together with the (owned)
+ *  RegexPattern it was created from
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriRegexMatcherDeleter {
+    void operator()(RegexMatcher* matcher) const {
+        const RegexPattern* pattern = &matcher->pattern();
+        delete matcher;
+        delete pattern;
+    }
+};
+
+
 
 /**
  * A class to handle regex searches
@@ -69,22 +104,31 @@ struct StriRegexMatcherOptions {
  *
  * @version 1.7.1 (Marek Gagolewski, 2021-06-19)
  *          #153: extract capture group names
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *          compiled patterns are taken from a process-wide LRU cache;
+ *          keep one matcher per distinct pattern
  */
 class StriContainerRegexPattern : public StriContainerUTF16 {
 
 private:
 
     StriRegexMatcherOptions opts; ///< RegexMatcher options
-    RegexMatcher* lastMatcher; ///< recently used RegexMatcher
+    StriMatcherTable<RegexMatcher*, StriRegexMatcherDeleter> matchers; ///< one per distinct pattern
+    RegexMatcher* lastMatcher; ///< recently used RegexMatcher (owned by matchers)
     R_len_t lastMatcherIndex;  ///< used by vectorize_getMatcher
 
     std::vector<std::string> lastCaptureGroupNames;
     R_len_t lastCaptureGroupNamesIndex;
 
+    RegexMatcher* createMatcher(R_len_t i);
+
 public:
 
     static StriRegexMatcherOptions getRegexOptions(SEXP opts_regex);
 
+    static RegexPattern* compilePattern(const UnicodeString& pattern, uint32_t flags, UErrorCode& status);
+
     StriContainerRegexPattern();
     StriContainerRegexPattern(SEXP rstr, R_len_t nrecycle, StriRegexMatcherOptions opts);
     StriContainerRegexPattern(StriContainerRegexPattern& container);
@@ -97,4 +141,34 @@ public:
     SEXP getCaptureGroupRNames(R_len_t i);  // TODO: allow reuse
 };
 
+
+
+/**
+ * A replacement string for RegexMatcher, preprocessed so that
+ * the replaced strings can be assembled in UTF-8 directly,
+ * with the input searched in via UText
+ *
+ * The syntax is the same as in RegexMatcher::appendReplacement:
+ * $n and ${name} refer to capture groups and a backslash
+ * escapes the next character (including the u and U code point escapes).
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriRegexReplacement {
+
+private:
+
+    std::vector<std::string> literals; ///< UTF-8 literals
+    std::vector<int32_t> groups;       ///< groups[k] >= 0 refers to a capture group, otherwise literals[k] is used
+
+    void appendLiteral(UnicodeString& literal);
+
+public:
+
+    StriRegexReplacement() { }
+    void compile(const UnicodeString& replacement, const RegexPattern& pattern, int32_t ngroups, UErrorCode& status);
+    void append(std::string& out, const char* str, RegexMatcher* matcher, UErrorCode& status,
+        int32_t group_offset=0) const;
+};
+
 #endif
@@ -42,6 +42,7 @@ StriContainerUStringSearch::StriContainerUStringSearch()
     : StriContainerUTF16()
 {
     this->lastMatcherIndex = -1;
+    this->lastMatcher = NULL;
     this->str = NULL;
     this->col = NULL;
 }
@@ -66,6 +67,9 @@ StriContainerUStringSearch::StriContainerUStringSearch(SEXP rstr, R_len_t _nrecy
             Rf_warning(MSG__EMPTY_SEARCH_PATTERN_UNSUPPORTED);
         }
     }
+
+    StriContainerUTF16Hash hash(this);
+    matchers.init(n, get_nrecycle(), hash, hash);
 }
 
 
@@ -78,16 +82,17 @@ StriContainerUStringSearch::StriContainerUStringSearch(StriContainerUStringSearc
     this->lastMatcherIndex = -1;
     this->lastMatcher = NULL;
     this->col = container.col;
+    this->matchers.init(container.matchers);
 }
 
 
 StriContainerUStringSearch& StriContainerUStringSearch::operator=(StriContainerUStringSearch& container)
 {
-    this->~StriContainerUStringSearch();
     (StriContainerUTF16&) (*this) = (StriContainerUTF16&)container;
     this->lastMatcherIndex = -1;
     this->lastMatcher = NULL;
     this->col = container.col;
+    this->matchers.init(container.matchers);
     return *this;
 }
 
@@ -97,10 +102,8 @@ StriContainerUStringSearch& StriContainerUStringSearch::operator=(StriContainerU
  */
 StriContainerUStringSearch::~StriContainerUStringSearch()
 {
-    if (lastMatcher) {
-        usearch_close(lastMatcher);
-        lastMatcher = NULL;
-    }
+    // matchers are disposed of by StriMatcherTable
+    lastMatcher = NULL;
     col = NULL;
     // col is owned by the caller
 }
@@ -130,33 +133,35 @@ UStringSearch* StriContainerUStringSearch::getMatcher(R_len_t i, const UnicodeSt
  * @param i index
  * @param searchStr string to search in
  * @param searchStr_len string length in UChars
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    each distinct pattern gets its own matcher, which is reused
+ *    throughout the whole call
  */
 UStringSearch* StriContainerUStringSearch::getMatcher(R_len_t i, const UChar* searchStr, int32_t searchStr_len)
 {
-    if (!lastMatcher) {
+    UErrorCode status = U_ZERO_ERROR;
+    if (lastMatcher && this->lastMatcherIndex == (i % n)) {
+        // do nothing => matcher reuse
+    }
+    else if ((lastMatcher = matchers.get(i % n)) != NULL) {
         this->lastMatcherIndex = (i % n);
-        UErrorCode status = U_ZERO_ERROR;
-        lastMatcher = usearch_openFromCollator(
+    }
+    else {
+        UStringSearch* matcher = usearch_openFromCollator(
             this->get(i).getBuffer(),
             this->get(i).length(),
             searchStr, searchStr_len, this->col, NULL, &status);
-        STRI__CHECKICUSTATUS_THROW(status, {usearch_close(lastMatcher); lastMatcher = NULL;})
-        return lastMatcher;
-    }
+        STRI__CHECKICUSTATUS_THROW(status, {usearch_close(matcher);})
 
-    if (this->lastMatcherIndex == (i % n)) {
-        // do nothing => matcher reuse
-    }
-    else {
+        matchers.set(i % n, matcher);
+        lastMatcher = matcher;
         this->lastMatcherIndex = (i % n);
-        UErrorCode status = U_ZERO_ERROR;
-        usearch_setPattern(lastMatcher, this->get(i).getBuffer(), this->get(i).length(), &status);
-        STRI__CHECKICUSTATUS_THROW(status, {usearch_close(lastMatcher); lastMatcher = NULL;})
+        return lastMatcher;
     }
 
-    UErrorCode status = U_ZERO_ERROR;
     usearch_setText(lastMatcher, searchStr, searchStr_len, &status);
-    STRI__CHECKICUSTATUS_THROW(status, {usearch_close(lastMatcher); lastMatcher = NULL;})
+    STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
 
     return lastMatcher;
 }
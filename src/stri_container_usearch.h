@@ -55,13 +55,21 @@
  *
  * @version 1.3.1 (Marek Gagolewski, 2019-02-06)
  *          #337: warn on empty search pattern here
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *          keep one matcher per distinct pattern
  */
 class StriContainerUStringSearch : public StriContainerUTF16 {
 
 private:
 
     UCollator* col; ///< collator, owned by creator
-    UStringSearch* lastMatcher; ///< recently used UStringSearch
+    struct MatcherDeleter {
+        void operator()(UStringSearch* matcher) const { usearch_close(matcher); }
+    };
+
+    StriMatcherTable<UStringSearch*, MatcherDeleter> matchers; ///< one per distinct pattern
+    UStringSearch* lastMatcher; ///< recently used UStringSearch (owned by matchers)
     R_len_t lastMatcherIndex;  ///< used by vectorize_getMatcher
 
 
@@ -32,6 +32,7 @@
 
 #include "stri_stringi.h"
 #include "stri_container_utf16.h"
+#include "stri_cache.h"
 #include "stri_string8buf.h"
 #include "stri_ucnv.h"
 
@@ -153,31 +154,30 @@ StriContainerUTF16::StriContainerUTF16(SEXP rstr, R_len_t _nrecycle, bool _shall
             // the input string length to 858993458 characters (#487)
             this->str[i].setTo(UnicodeString::fromUTF8(CHAR(curs)));
         }
-        else if (IS_LATIN1(curs)) {
-            UConverter* ucnv = ucnvLatin1.getConverter();
-            UErrorCode status = U_ZERO_ERROR;
-            this->str[i].setTo(
-                UnicodeString((const char*)CHAR(curs), (int32_t)LENGTH(curs), ucnv, status)
-            );
-            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-        }
         else if (IS_BYTES(curs)) {
             throw StriException(MSG__BYTESENC);
         }
-        else {
+        else if (!IS_LATIN1(curs) && ucnvNative.isUTF8()) {
             // an "unknown" (native) encoding may be set to UTF-8 (speedup)
-            if (ucnvNative.isUTF8()) {
-                // UTF-8
-                this->str[i].setTo(UnicodeString::fromUTF8(CHAR(curs)));
-            }
-            else {
-                UConverter* ucnv = ucnvNative.getConverter();
-                UErrorCode status = U_ZERO_ERROR;
-                this->str[i].setTo(
-                    UnicodeString((const char*)CHAR(curs), (int32_t)LENGTH(curs), ucnv, status)
-                );
-                STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            this->str[i].setTo(UnicodeString::fromUTF8(CHAR(curs)));
+        }
+        else {
+            // LATIN1 ------- OR ------ Native encoding
+            StriConversionCacheEntry* cached = stri__conversion_cache_get(curs);
+            if (cached && !cached->utf16.isBogus()) {
+                this->str[i].setTo(cached->utf16);  // shares the buffer
+                continue;
             }
+
+            UConverter* ucnv = IS_LATIN1(curs)?ucnvLatin1.getConverter():ucnvNative.getConverter();
+            UErrorCode status = U_ZERO_ERROR;
+            this->str[i].setTo(
+                UnicodeString((const char*)CHAR(curs), (int32_t)LENGTH(curs), ucnv, status)
+            );
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+            if (!cached) cached = stri__conversion_cache_put(curs);
+            if (cached) cached->utf16 = this->str[i];
         }
     }
 
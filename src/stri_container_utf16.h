@@ -164,4 +164,26 @@ public:
 SEXP stri__subset_by_logical(const StriContainerUTF16& str_cont,
                              const std::vector<int>& which, int result_counter);
 
+
+/** Hashes and compares the strings in a container;
+ *  see StriMatcherTable::init()
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriContainerUTF16Hash {
+    const StriContainerUTF16* cont;
+
+    StriContainerUTF16Hash(const StriContainerUTF16* _cont) : cont(_cont) { }
+
+    size_t operator()(R_len_t i) const {
+        if (cont->isNA(i)) return 0;
+        return (size_t)cont->get(i).hashCode();
+    }
+
+    bool operator()(R_len_t i, R_len_t j) const {
+        if (cont->isNA(i) || cont->isNA(j)) return cont->isNA(i) && cont->isNA(j);
+        return cont->get(i) == cont->get(j);
+    }
+};
+
 #endif
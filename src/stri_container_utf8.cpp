@@ -32,6 +32,7 @@
 
 #include "stri_stringi.h"
 #include "stri_container_utf8.h"
+#include "stri_cache.h"
 #include "stri_ucnv.h"
 #include "stri_string8buf.h"
 
@@ -141,6 +142,13 @@ StriContainerUTF8::StriContainerUTF8(SEXP rstr, R_len_t _nrecycle, bool _shallow
                 ucnvCurrent = ucnvNative.getConverter();
             }
 
+            StriConversionCacheEntry* cached = stri__conversion_cache_get(curs);
+            if (cached && cached->has_utf8) {
+                this->str[i].initialize(cached->utf8.data(), (R_len_t)cached->utf8.size(),
+                    true/*memalloc*/, false/*killbom*/, false/*isASCII*/);
+                continue;
+            }
+
             if (outbufsize < 0) {
                 // calculate max string length
                 R_len_t maxlen = LENGTH(curs);
@@ -204,6 +212,12 @@ StriContainerUTF8::StriContainerUTF8(SEXP rstr, R_len_t _nrecycle, bool _shallow
 
             this->str[i].initialize(outbuf.data(), outrealsize, true/*memalloc*/, false/*killbom*/, false/*isASCII*/);
 
+            if (!cached) cached = stri__conversion_cache_put(curs);
+            if (cached) {
+                cached->utf8.assign(outbuf.data(), (size_t)outrealsize);
+                cached->has_utf8 = true;
+            }
+
             // version 3: use tmpbuf (slower than v2)
 //               UErrorCode status = U_ZERO_ERROR;
 //               int tmprealsize = ucnv_toUChars(ucnvCurrent, tmpbuf, tmpbufsize,
@@ -45,6 +45,9 @@ StriContainerUTF8_indexable::StriContainerUTF8_indexable()
 {
     last_ind_back_str = NULL;
     last_ind_fwd_str = NULL;
+    ind_sample_utf8 = NULL;
+    ind_sample_capacity = 0;
+    ind_sample_reset();
 }
 
 
@@ -62,6 +65,9 @@ StriContainerUTF8_indexable::StriContainerUTF8_indexable(SEXP rstr, R_len_t _nre
 {
     last_ind_back_str = NULL;
     last_ind_fwd_str = NULL;
+    ind_sample_utf8 = NULL;
+    ind_sample_capacity = 0;
+    ind_sample_reset();
 }
 
 
@@ -75,6 +81,9 @@ StriContainerUTF8_indexable::StriContainerUTF8_indexable(StriContainerUTF8_index
 {
     last_ind_back_str = NULL;
     last_ind_fwd_str = NULL;
+    ind_sample_utf8 = NULL;
+    ind_sample_capacity = 0;
+    ind_sample_reset();
 }
 
 
@@ -82,6 +91,9 @@ StriContainerUTF8_indexable::StriContainerUTF8_indexable(StriContainerUTF8_index
  *
  *  @version 0.2-1 (2014-03-20)
  *           separated StriContainerUTF8_indexable class
+ *
+ *  @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *           free the sampled code point index
  */
 StriContainerUTF8_indexable& StriContainerUTF8_indexable::operator=(StriContainerUTF8_indexable& container)
 {
@@ -90,11 +102,133 @@ StriContainerUTF8_indexable& StriContainerUTF8_indexable::operator=(StriContaine
 
     last_ind_back_str = NULL;
     last_ind_fwd_str = NULL;
+    if (ind_sample_utf8) {
+        delete [] ind_sample_utf8;
+        ind_sample_utf8 = NULL;
+    }
+    ind_sample_capacity = 0;
+    ind_sample_reset();
 
     return *this;
 }
 
 
+/** Destructor
+ *
+ *  @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *           free the sampled code point index
+ */
+StriContainerUTF8_indexable::~StriContainerUTF8_indexable()
+{
+    if (ind_sample_utf8) {
+        delete [] ind_sample_utf8;
+        ind_sample_utf8 = NULL;
+    }
+    ind_sample_capacity = 0;
+}
+
+
+/** Forget the sampled code point index (but keep the buffer)
+ *
+ *  @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+void StriContainerUTF8_indexable::ind_sample_reset()
+{
+    ind_sample_codepoints = -1;
+    ind_sample_scanned = 0;
+    ind_sample_str = NULL;
+}
+
+
+/** Account for a linear scan over the i-th string and build
+ *  its sampled code point index if it pays off
+ *
+ * The index is built once the number of code points visited
+ * by the linear scans exceeds the string's length in bytes,
+ * i.e., when they have become more expensive than building the index.
+ * This keeps the cost of stri_sub & co. at most twice that of the
+ * linear scans for sequential access patterns,
+ * whilst random access to long strings takes
+ * O(STRI__UTF8_INDEX_SAMPLE_STEP) time per lookup.
+ *
+ * @param i string index (in container)
+ * @param scanned number of code points visited by a linear scan
+ * @return whether the index is available
+ *
+ *  @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+bool StriContainerUTF8_indexable::ind_sample_update(R_len_t i, R_len_t scanned)
+{
+    R_len_t cur_n = get(i).length();
+    const char* cur_s = get(i).c_str();
+
+    if (ind_sample_str != cur_s) {
+        // a different string
+        ind_sample_reset();
+        ind_sample_str = cur_s;
+    }
+
+    if (ind_sample_codepoints != -1)  // already built or not available
+        return (ind_sample_codepoints >= 0);
+
+    ind_sample_scanned += scanned;
+    if (ind_sample_scanned <= cur_n || cur_n < 4*STRI__UTF8_INDEX_SAMPLE_STEP)
+        return false; // linear scans are still cheaper
+
+    // U8_FWD_1 and U8_BACK_1 are consistent with each other on valid UTF-8 only
+    if (!stri__utf8_is_valid(cur_s, cur_n)) {
+        ind_sample_codepoints = -2;
+        return false;
+    }
+
+    R_len_t needed = cur_n/STRI__UTF8_INDEX_SAMPLE_STEP+1;
+    if (needed > ind_sample_capacity) {
+        if (ind_sample_utf8) delete [] ind_sample_utf8;
+        ind_sample_utf8 = new R_len_t[needed];
+        STRI_ASSERT(ind_sample_utf8);
+        if (!ind_sample_utf8) throw StriException(MSG__MEM_ALLOC_ERROR_WITH_SIZE,
+                                                  needed*sizeof(R_len_t));
+        ind_sample_capacity = needed;
+    }
+
+    R_len_t jres = 0;
+    R_len_t j = 0;
+    R_len_t k = 0;
+    while (jres < cur_n) {
+        if (j % STRI__UTF8_INDEX_SAMPLE_STEP == 0)
+            ind_sample_utf8[k++] = jres;
+        U8_FWD_1((const uint8_t*)cur_s, jres, cur_n);
+        ++j;
+    }
+
+    ind_sample_codepoints = j;
+    return true;
+}
+
+
+/** Convert FORWARD UChar32-based index to UTF-8 based
+ *  using the sampled code point index
+ *
+ * @param i string index (in container)
+ * @param wh UChar32 character's position to look for, wh > 0
+ * @return UTF-8 (byte) index
+ *
+ *  @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+R_len_t StriContainerUTF8_indexable::ind_sample_get(R_len_t i, R_len_t wh)
+{
+    R_len_t cur_n = get(i).length();
+    if (wh >= ind_sample_codepoints) return cur_n;
+
+    const char* cur_s = get(i).c_str();
+    R_len_t jres = ind_sample_utf8[wh/STRI__UTF8_INDEX_SAMPLE_STEP];
+    for (R_len_t j = wh%STRI__UTF8_INDEX_SAMPLE_STEP; j > 0; --j)
+        U8_FWD_1((const uint8_t*)cur_s, jres, cur_n);
+
+    return jres;
+}
+
+
 /** Convert BACKWARD UChar32-based index to UTF-8 based
  *
  * @param i string index (in container)
@@ -120,6 +254,9 @@ StriContainerUTF8_indexable& StriContainerUTF8_indexable::operator=(StriContaine
  *
  * @version 1.1.3 (Marek Gagolewski, 2017-03-21)
  *          Issue#227: buffering bug in stri_sub
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *          use the sampled code point index for long strings
  */
 R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_back(R_len_t i, R_len_t wh)
 {
@@ -133,6 +270,11 @@ R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_back(R_len_t i, R_len
         throw StriException("StriContainerUTF8::UChar32_to_UTF8_index_back: NULL cur_s");
 #endif
 
+    if (ind_sample_update(i, 0)) {
+        if (wh >= ind_sample_codepoints) return 0;
+        return ind_sample_get(i, ind_sample_codepoints-wh);
+    }
+
     if (last_ind_back_str != cur_s) {
         // starting search in a different string
         last_ind_back_codepoint = 0;
@@ -157,6 +299,7 @@ R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_back(R_len_t i, R_len
                     --j;
                 }
 
+                ind_sample_update(i, last_ind_back_codepoint-j);
                 last_ind_back_codepoint = wh;
                 last_ind_back_utf8 = jres;
                 return jres; // stop right now
@@ -170,11 +313,14 @@ R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_back(R_len_t i, R_len
     }
 
     // go backward
+    R_len_t jstart = j;
     while (j < wh && jres > 0) {
         U8_BACK_1((const uint8_t*)cur_s, 0, jres);
         ++j;
     }
 
+    ind_sample_update(i, j-jstart);
+
     last_ind_back_codepoint = j; // it's not wh, as we can advance at the end of the string, compare #227
     last_ind_back_utf8 = jres;
 
@@ -207,6 +353,9 @@ R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_back(R_len_t i, R_len
  *
  * @version 1.1.3 (Marek Gagolewski, 2017-03-21)
  *          Issue#227: buffering bug in stri_sub
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *          use the sampled code point index for long strings
  */
 R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_fwd(R_len_t i, R_len_t wh)
 {
@@ -222,6 +371,9 @@ R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_fwd(R_len_t i, R_len_
 #endif
 
 
+    if (ind_sample_update(i, 0))
+        return ind_sample_get(i, wh);
+
     if (last_ind_fwd_str != cur_s) {
         // starting search in a different string
         last_ind_fwd_codepoint = 0;
@@ -245,6 +397,7 @@ R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_fwd(R_len_t i, R_len_
                     --j;
                 }
 
+                ind_sample_update(i, last_ind_fwd_codepoint-j);
                 last_ind_fwd_codepoint = wh;
                 last_ind_fwd_utf8 = jres;
                 return jres; // stop right now
@@ -258,11 +411,14 @@ R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_fwd(R_len_t i, R_len_
     }
 
     // go forward
+    R_len_t jstart = j;
     while (j < wh && jres < cur_n) {
         U8_FWD_1((const uint8_t*)cur_s, jres, cur_n);
         ++j;
     }
 
+    ind_sample_update(i, j-jstart);
+
     last_ind_fwd_codepoint = j; // it's not wh, as we can advance at the end of the string, compare #227
     last_ind_fwd_utf8 = jres;
     return jres;
@@ -271,7 +427,8 @@ R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_fwd(R_len_t i, R_len_
 
 /** Convert UTF8-byte indexes to Unicode32 (code points)
 *
-* \code{i1} and \code{i2} must be sorted increasingly
+* \code{i1} and \code{i2} must be sorted nondecreasingly
+* (NA and negative indexes are ignored)
 *
 * @param i element index
 * @param i1 indexes, 1-based [in/out]
@@ -288,14 +445,18 @@ R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_fwd(R_len_t i, R_len_
 *
 * @version 0.5-1 (Marek Gagolewski, 2015-02-14)
 *          use String8::isASCII
+*
+* @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+*    ignore NA and negative indexes, allow ties
+*    (as in StriContainerUTF16::UChar16_to_UChar32_index)
 */
 void StriContainerUTF8_indexable::UTF8_to_UChar32_index(R_len_t i,
         int* i1, int* i2, const int ni, int adj1, int adj2)
 {
     if (get(i).isASCII()) {
         for (int i=0; i<ni; ++i) {
-            i1[i] += adj1;
-            i2[i] += adj2;
+            if (i1[i] != NA_INTEGER && i1[i] >= 0) i1[i] += adj1;
+            if (i2[i] != NA_INTEGER && i2[i] >= 0) i2[i] += adj2;
         }
         return;
     }
@@ -310,19 +471,21 @@ void StriContainerUTF8_indexable::UTF8_to_UChar32_index(R_len_t i,
     int i32 = 0;
     while (i8 < nstr && (j1 < ni || j2 < ni)) {
 
-        if (j1 < ni && i1[j1] <= i8) {
+        while (j1 < ni && i1[j1] <= i8) {
+            if (i1[j1] == NA_INTEGER || i1[j1] < 0) { ++j1; continue; }
 #ifndef NDEBUG
-            if (j1 < ni-1 && i1[j1] >= i1[j1+1])
-                throw StriException("DEBUG: stri__UTF8_to_UChar32_index");
+            if (j1 < ni-1 && i1[j1+1] != NA_INTEGER && i1[j1+1] >= 0 && i1[j1] > i1[j1+1])
+                throw StriException("DEBUG: stri__UTF8_to_UChar32_index 1");
 #endif
             i1[j1] = i32 + adj1;
             ++j1;
         }
 
-        if (j2 < ni && i2[j2] <= i8) {
+        while (j2 < ni && i2[j2] <= i8) {
+            if (i2[j2] == NA_INTEGER || i2[j2] < 0) { ++j2; continue; }
 #ifndef NDEBUG
-            if (j2 < ni-1 && i2[j2] >= i2[j2+1])
-                throw StriException("DEBUG: stri__UTF8_to_UChar32_index");
+            if (j2 < ni-1 && i2[j2+1] != NA_INTEGER && i2[j2+1] >= 0 && i2[j2] > i2[j2+1])
+                throw StriException("DEBUG: stri__UTF8_to_UChar32_index 2");
 #endif
             i2[j2] = i32 + adj2;
             ++j2;
@@ -334,20 +497,14 @@ void StriContainerUTF8_indexable::UTF8_to_UChar32_index(R_len_t i,
     }
 
     // CONVERT LAST:
-    if (j1 < ni && i1[j1] <= nstr) {
-#ifndef NDEBUG
-        if (j1 < ni-1 && i1[j1] >= i1[j1+1])
-            throw StriException("DEBUG: stri__UTF8_to_UChar32_index");
-#endif
+    while (j1 < ni && i1[j1] <= nstr) {
+        if (i1[j1] == NA_INTEGER || i1[j1] < 0) { ++j1; continue; }
         i1[j1] = i32 + adj1;
         ++j1;
     }
 
-    if (j2 < ni && i2[j2] <= nstr) {
-#ifndef NDEBUG
-        if (j2 < ni-1 && i2[j2] >= i2[j2+1])
-            throw StriException("DEBUG: stri__UTF8_to_UChar32_index");
-#endif
+    while (j2 < ni && i2[j2] <= nstr) {
+        if (i2[j2] == NA_INTEGER || i2[j2] < 0) { ++j2; continue; }
         i2[j2] = i32 + adj2;
         ++j2;
     }
@@ -355,6 +512,6 @@ void StriContainerUTF8_indexable::UTF8_to_UChar32_index(R_len_t i,
     // CHECK:
 #ifndef NDEBUG
     if (i8 >= nstr && (j1 < ni || j2 < ni))
-        throw StriException("DEBUG: stri__UTF8_to_UChar32_index()");
+        throw StriException("DEBUG: stri__UTF8_to_UChar32_index 3");
 #endif
 }
@@ -36,6 +36,11 @@
 #include "stri_container_utf8.h"
 
 
+/** every how many code points the sampled UChar32 to UTF-8 index
+ *  records a byte position */
+#define STRI__UTF8_INDEX_SAMPLE_STEP 64
+
+
 /**
  * A class to handle conversion between R character
  * vectors and UTF-8 string vectors,
@@ -47,6 +52,10 @@
  *
  * @version 0.5-1 (Marek Gagolewski, 2015-02-14)
  *          use String8::isASCII
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *          a lazily built sampled code point index for random access
+ *          to long strings
  */
 class StriContainerUTF8_indexable : public StriContainerUTF8 {
 
@@ -62,12 +71,28 @@ private:
     R_len_t last_ind_back_utf8;
     const char* last_ind_back_str;
 
+    // a sampled UChar32 to UTF-8 index of the string ind_sample_str:
+    // ind_sample_utf8[k] == byte position of the
+    // (k*STRI__UTF8_INDEX_SAMPLE_STEP)-th code point;
+    // built once the linear scans of the string have become
+    // more expensive than a single pass over it
+    R_len_t* ind_sample_utf8;
+    R_len_t ind_sample_capacity;
+    R_len_t ind_sample_codepoints; // -1 == not built yet, -2 == not available
+    R_len_t ind_sample_scanned;    // code points visited by linear scans
+    const char* ind_sample_str;
+
+    void ind_sample_reset();
+    bool ind_sample_update(R_len_t i, R_len_t scanned);
+    R_len_t ind_sample_get(R_len_t i, R_len_t wh);
+
 public:
 
     StriContainerUTF8_indexable();
     StriContainerUTF8_indexable(SEXP rstr, R_len_t nrecycle, bool shallowrecycle=true);
     StriContainerUTF8_indexable(StriContainerUTF8_indexable& container);
     StriContainerUTF8_indexable& operator=(StriContainerUTF8_indexable& container);
+    ~StriContainerUTF8_indexable();
 
     void UTF8_to_UChar32_index(R_len_t i, int* i1, int* i2, const int ni, int adj1, int adj2);
     R_len_t UChar32_to_UTF8_index_back(R_len_t i, R_len_t wh);
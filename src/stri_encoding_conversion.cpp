@@ -37,6 +37,7 @@
 #include "stri_container_listint.h"
 #include "stri_string8buf.h"
 #include "stri_ucnv.h"
+#include "stri_transcoder.h"
 #include <vector>
 
 
@@ -217,6 +218,9 @@ SEXP stri_enc_toutf32(SEXP str)
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-04)
  *    Issue #112: str_prepare_arg* retvals were not PROTECTed from gc
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    validate with stri__utf8_is_valid
  */
 SEXP stri_enc_toutf8(SEXP str, SEXP is_unknown_8bit, SEXP validate)
 {
@@ -299,13 +303,10 @@ SEXP stri_enc_toutf8(SEXP str, SEXP is_unknown_8bit, SEXP validate)
 
             const char* s = CHAR(curs);  // TODO: ALTREP will be problematic?
             R_len_t sn = LENGTH(curs);
+            if (stri__utf8_is_valid(s, sn)) continue; // valid, nothing to do
+
             R_len_t j = 0;
             UChar32 c = 0;
-            while (c >= 0 && j < sn) {
-                U8_NEXT(s, j, sn, c);
-            }
-
-            if (c >= 0) continue; // valid, nothing to do
 
             if (LOGICAL(validate)[0] == NA_LOGICAL) {
                 Rf_warning(MSG__INVALID_CODE_POINT_REPLNA);
@@ -546,6 +547,33 @@ SEXP stri_encode_from_marked(SEXP str, SEXP to, SEXP to_raw)
 }
 
 
+/** Store a converted string in the result of stri_encode
+ *
+ * @param ret list or character vector
+ * @param i index
+ * @param s converted string
+ * @param n number of bytes
+ * @param to_raw whether ret is a list of raw vectors
+ * @param encmark encoding mark for the string
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static void stri__encode_set_result(SEXP ret, R_len_t i, const char* s, R_len_t n,
+    bool to_raw, cetype_t encmark)
+{
+    if (to_raw) {
+        SEXP outobj;
+        PROTECT(outobj = Rf_allocVector(RAWSXP, n));
+        memcpy(RAW(outobj), s, (size_t)n);
+        SET_VECTOR_ELT(ret, i, outobj);
+        UNPROTECT(1);
+    }
+    else {
+        SET_STRING_ELT(ret, i, Rf_mkCharLenCE(s, n, encmark));
+    }
+}
+
+
 /**
  * Convert character vector between given encodings
  *
@@ -577,6 +605,9 @@ SEXP stri_encode_from_marked(SEXP str, SEXP to, SEXP to_raw)
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-04)
  *    Issue #112: str_prepare_arg* retvals were not PROTECTed from gc
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    use StriTranscoder for UTF-8/16/32 and single-byte code pages
  */
 SEXP stri_encode(SEXP str, SEXP from, SEXP to, SEXP to_raw)
 {
@@ -609,6 +640,9 @@ SEXP stri_encode(SEXP str, SEXP from, SEXP to, SEXP to_raw)
     // Get target encoding mark
     cetype_t encmark_to = to_raw_logical?CE_BYTES:ucnv2.getCE();
 
+    // Common encoding pairs may be converted without the UTF-16 detour
+    StriTranscoder transcoder(ucnv1, ucnv2);
+
     SEXP ret;
     STRI__PROTECT(ret = Rf_allocVector(to_raw_logical?VECSXP:STRSXP, str_n));
 
@@ -634,6 +668,12 @@ SEXP stri_encode(SEXP str, SEXP from, SEXP to, SEXP to_raw)
         const char* curs = str_cont.get(i).c_str();
         R_len_t curn     = str_cont.get(i).length();
 
+        R_len_t bufused;
+        if (transcoder.convert(curs, curn, buf, bufused)) { // FROM -> TO directly
+            stri__encode_set_result(ret, i, buf.data(), bufused, to_raw_logical, encmark_to);
+            continue;
+        }
+
         UErrorCode status = U_ZERO_ERROR;
         UnicodeString encs(curs, curn, uconv_from, status); // FROM -> UTF-16 [this is the slow part]
         if (status == U_ILLEGAL_ARGUMENT_ERROR)
@@ -670,16 +710,7 @@ SEXP stri_encode(SEXP str, SEXP from, SEXP to, SEXP to_raw)
             STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
         }
 
-        if (to_raw_logical) {
-            SEXP outobj;
-            STRI__PROTECT(outobj = Rf_allocVector(RAWSXP, bufneed));
-            memcpy(RAW(outobj), buf.data(), (size_t)bufneed);
-            SET_VECTOR_ELT(ret, i, outobj);
-            STRI__UNPROTECT(1);
-        }
-        else {
-            SET_STRING_ELT(ret, i, Rf_mkCharLenCE(buf.data(), bufneed, encmark_to));
-        }
+        stri__encode_set_result(ret, i, buf.data(), (R_len_t)bufneed, to_raw_logical, encmark_to);
     }
 
     STRI__UNPROTECT_ALL
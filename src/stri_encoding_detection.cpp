@@ -103,8 +103,14 @@ double stri__enc_check_8bit(const char* str_cur_s, R_len_t str_cur_n, bool get_c
  *
  * @version 0.1-?? (Marek Gagolewski, 2013-08-13)
  *          warnchars count added
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *          exact check with stri__ascii_is_valid
  */
 double stri__enc_check_ascii(const char* str_cur_s, R_len_t str_cur_n, bool get_confidence) {
+    if (!get_confidence)
+        return stri__ascii_is_valid(str_cur_s, str_cur_n)?1.0:0.0;
+
     R_len_t warnchars = 0;
     for (R_len_t j=0; j < str_cur_n; ++j) {
         if (!U8_IS_SINGLE(str_cur_s[j]) || str_cur_s[j] == 0) // i.e., 0 < c <= 127
@@ -144,20 +150,15 @@ double stri__enc_check_ascii(const char* str_cur_s, R_len_t str_cur_n, bool get_
  *
  * @version 0.1-?? (Marek Gagolewski, 2013-08-13)
  *          confidence calculation basing on ICU's i18n/csrutf8.cpp
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *          exact check with stri__utf8_is_valid
  */
 double stri__enc_check_utf8(const char* str_cur_s, R_len_t str_cur_n, bool get_confidence)
 {
     if (!get_confidence) {
-        UChar32 c;
-        for (R_len_t j=0; j < str_cur_n; ) {
-            if (str_cur_s[j] == 0)
-                return 0.0; // definitely not valid UTF-8
-
-            U8_NEXT(str_cur_s, j, str_cur_n, c);
-            if (c < 0) // ICU utf8.h doc for U8_NEXT: c -> output UChar32 variable, set to <0 in case of an error
-                return 0.0; // definitely not valid UTF-8
-        }
-        return 1.0;
+        // definitely not valid UTF-8 if there is a NUL or an ill-formed sequence
+        return stri__utf8_is_valid(str_cur_s, str_cur_n)?1.0:0.0;
     }
     else {
         // Based on ICU's i18n/csrutf8.cpp [with own mods]
@@ -571,6 +572,103 @@ SEXP stri_enc_isutf32le(SEXP str) {
 }
 
 
+#define STRI__ENC_DETECT_SAMPLE_PIECES 16
+
+
+/**
+ * A bounded-size sample of a byte string, used by stri_enc_detect
+ * on large inputs: the first half of the sample is a prefix
+ * of the input, and the other half consists of equally spaced pieces
+ * taken from the remaining part.
+ *
+ * The pieces start at offsets divisible by 4 and have lengths divisible
+ * by 4, so that UTF-16 and UTF-32 code units are not split.
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriEncDetectSample {
+
+private:
+
+    std::string m_buf;
+    std::vector< std::pair<R_len_t, bool> > m_pieces;  // (start in m_buf, reaches the end of the input?)
+
+
+    void add(const char* s, R_len_t from, R_len_t to, R_len_t n)
+    {
+        m_pieces.push_back(std::pair<R_len_t, bool>((R_len_t)m_buf.size(), to >= n));
+        m_buf.append(s+from, (size_t)(to-from));
+    }
+
+
+public:
+
+    /** Take a sample
+     *
+     * @param s input bytes
+     * @param n number of bytes
+     * @param sample_size maximal sample size
+     */
+    void set(const char* s, R_len_t n, R_len_t sample_size)
+    {
+        m_buf.clear();
+        m_pieces.clear();
+
+        if (n <= sample_size) {
+            add(s, 0, n, n);
+            return;
+        }
+
+        R_len_t prefix = (sample_size/2) & ~3;
+        R_len_t piece = ((sample_size-prefix)/STRI__ENC_DETECT_SAMPLE_PIECES) & ~3;
+        if (piece <= 0) {
+            add(s, 0, sample_size & ~3, n);
+            return;
+        }
+
+        add(s, 0, prefix, n);
+        double span = (double)(n-prefix-piece);
+        for (R_len_t k=1; k<=STRI__ENC_DETECT_SAMPLE_PIECES; ++k) {
+            R_len_t from = (prefix+(R_len_t)(span*k/STRI__ENC_DETECT_SAMPLE_PIECES)) & ~3;
+            add(s, from, min(from+piece, n), n);
+        }
+    }
+
+
+    const char* data() const { return m_buf.data(); }
+    R_len_t length() const { return (R_len_t)m_buf.size(); }
+
+
+    /** Is each piece valid UTF-8, apart from the code points
+     *  split at the piece boundaries?
+     */
+    bool isUTF8() const
+    {
+        const char* str_cur_s = m_buf.data();
+        for (size_t k=0; k<m_pieces.size(); ++k) {
+            R_len_t from = m_pieces[k].first;
+            R_len_t to = (k+1 < m_pieces.size())?m_pieces[k+1].first:(R_len_t)m_buf.size();
+
+            if (k > 0) {  // skip the tail of a code point that started before the piece
+                for (R_len_t i=0; i<3 && from < to && U8_IS_TRAIL(str_cur_s[from]); ++i)
+                    ++from;
+            }
+
+            if (!m_pieces[k].second && from < to) {  // cut off an incomplete code point
+                R_len_t p = to-1;
+                while (p > from && p > to-4 && U8_IS_TRAIL(str_cur_s[p])) --p;
+                if (U8_IS_LEAD(str_cur_s[p]) && U8_COUNT_TRAIL_BYTES((uint8_t)str_cur_s[p])+1 > to-p)
+                    to = p;
+            }
+
+            if (stri__enc_check_utf8(str_cur_s+from, to-from, false) == 0.0)
+                return false;
+        }
+        return true;
+    }
+};
+
+
 /** Detect encoding and language
  *
  * @param str character vector
@@ -585,16 +683,24 @@ SEXP stri_enc_isutf32le(SEXP str) {
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-04)
  *    Issue #112: str_prepare_arg* retvals were not PROTECTed from gc
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    sample_size arg added: examine a bounded-size sample;
+ *    valid UTF-8 samples are recognised without calling ICU
  */
-SEXP stri_enc_detect(SEXP str, SEXP filter_angle_brackets)
+SEXP stri_enc_detect(SEXP str, SEXP filter_angle_brackets, SEXP sample_size)
 {
     PROTECT(str = stri__prepare_arg_list_raw(str, "str"));
     PROTECT(filter_angle_brackets = stri__prepare_arg_logical(filter_angle_brackets, "filter_angle_brackets"));
+    PROTECT(sample_size = stri__prepare_arg_integer_1(sample_size, "sample_size"));
+    R_len_t sample_size_val = INTEGER(sample_size)[0];
+    if (sample_size_val != NA_INTEGER && sample_size_val <= 0)
+        Rf_error(MSG__INCORRECT_NAMED_ARG, "sample_size");  // error() call allowed here
 
     UCharsetDetector* ucsdet = NULL;
 
 
-    STRI__ERROR_HANDLER_BEGIN(2)
+    STRI__ERROR_HANDLER_BEGIN(3)
 
     UErrorCode status = U_ZERO_ERROR;
     ucsdet = ucsdet_open(&status);
@@ -620,6 +726,14 @@ SEXP stri_enc_detect(SEXP str, SEXP filter_angle_brackets)
     SET_VECTOR_ELT(wrong, 2, stri__vector_NA_integers(1));
     Rf_setAttrib(wrong, R_NamesSymbol, names);
 
+    SEXP isutf8;  // the result for samples that are valid UTF-8
+    STRI__PROTECT(isutf8 = Rf_allocVector(VECSXP, 3));
+    SET_VECTOR_ELT(isutf8, 0, Rf_mkString("UTF-8"));
+    SET_VECTOR_ELT(isutf8, 1, stri__vector_NA_strings(1));
+    SET_VECTOR_ELT(isutf8, 2, Rf_ScalarReal(1.0));
+    Rf_setAttrib(isutf8, R_NamesSymbol, names);
+
+    StriEncDetectSample sample;
     StriContainerLogical filter(filter_angle_brackets, vectorize_length);
     for (R_len_t i=0; i<vectorize_length; ++i) {
         if (str_cont.isNA(i) || filter.isNA(i)) {
@@ -630,6 +744,19 @@ SEXP stri_enc_detect(SEXP str, SEXP filter_angle_brackets)
         const char* str_cur_s = str_cont.get(i).c_str();
         R_len_t str_cur_n     = str_cont.get(i).length();
 
+        if (sample_size_val != NA_INTEGER) {
+            sample.set(str_cur_s, str_cur_n, sample_size_val);
+            str_cur_s = sample.data();
+            str_cur_n = sample.length();
+
+            // fast pre-pass: ASCII or UTF-8?
+            if (str_cur_n > 0 && (stri__enc_check_ascii(str_cur_s, str_cur_n, false) != 0.0
+                    || sample.isUTF8())) {
+                SET_VECTOR_ELT(ret, i, isutf8);
+                continue;
+            }
+        }
+
         status = U_ZERO_ERROR;
         ucsdet_setText(ucsdet, str_cur_s, str_cur_n, &status);
         STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
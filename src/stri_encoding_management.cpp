@@ -32,6 +32,7 @@
 
 #include "stri_stringi.h"
 #include "stri_ucnv.h"
+#include "stri_cache.h"
 
 
 /**
@@ -86,6 +87,7 @@ SEXP stri_enc_set(SEXP enc)
      Do not use unless you know what you are doing.
      */
     ucnv_setDefaultName(name); // set as default
+    stri__conversion_cache_base.clear(); // natively-encoded strings are to be converted anew
 
     return R_NilValue;
 
@@ -0,0 +1,418 @@
+/* This file is part of the 'stringi' project.
+ * Copyright (c) 2013-2026, Marek Gagolewski <https://www.gagolewski.com/>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "stri_stringi.h"
+
+// #define STRI__UTF8_VALIDATE_DISABLE_SIMD
+
+#if !defined(STRI__UTF8_VALIDATE_DISABLE_SIMD) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define STRI__UTF8_VALIDATE_SSE2
+#include <emmintrin.h>
+#if defined(__x86_64__)
+#define STRI__UTF8_VALIDATE_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+
+/** Check if a string is valid UTF-8 [one code point at a time]
+ *
+ * @param s string
+ * @param i where to start (at a code point boundary)
+ * @param n number of bytes
+ * @return whether s[i..n-1] is well-formed and has no NUL bytes
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static bool stri__utf8_is_valid_scalar(const char* s, R_len_t i, R_len_t n)
+{
+    UChar32 c;
+    while (i < n) {
+        if (s[i] == 0)
+            return false;
+
+        U8_NEXT(s, i, n, c);
+        if (c < 0) // ICU utf8.h doc for U8_NEXT: c -> output UChar32 variable, set to <0 in case of an error
+            return false;
+    }
+    return true;
+}
+
+
+#ifdef STRI__UTF8_VALIDATE_AVX2
+/** Is AVX2 available at runtime?
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static bool stri__utf8_has_avx2()
+{
+    static const bool has_avx2 = (bool)__builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+
+// error classes of the Keiser-Lemire algorithm;
+// each one is flagged by a pair of consecutive bytes
+#define STRI__UTF8_TOO_SHORT       (1<<0)  // 11______ 0_______, 11______ 11______
+#define STRI__UTF8_TOO_LONG        (1<<1)  // 0_______ 10______
+#define STRI__UTF8_OVERLONG_3      (1<<2)  // 11100000 100_____
+#define STRI__UTF8_TOO_LARGE       (1<<3)  // 11110100 1001____, 11110100 101_____
+#define STRI__UTF8_SURROGATE       (1<<4)  // 11101101 101_____
+#define STRI__UTF8_OVERLONG_2      (1<<5)  // 1100000_ 10______
+#define STRI__UTF8_TOO_LARGE_1000  (1<<6)  // 11110101+ 1000____
+#define STRI__UTF8_OVERLONG_4      (1<<6)  // 11110000 1000____
+#define STRI__UTF8_TWO_CONTS       (1<<7)  // 10______ 10______
+#define STRI__UTF8_CARRY           (STRI__UTF8_TOO_SHORT|STRI__UTF8_TOO_LONG|STRI__UTF8_TWO_CONTS)
+
+
+/** a 16-byte lookup table replicated in both 128-bit lanes */
+#define STRI__UTF8_LOOKUP16(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+
+
+/** the last n bytes of prev followed by the first 32-n bytes of cur */
+#define STRI__UTF8_PREV(cur, prev, n) \
+    _mm256_alignr_epi8((cur), _mm256_permute2x128_si256((prev), (cur), 0x21), 16-(n))
+
+
+/** Check if a string is valid UTF-8 using AVX2, 32 bytes at a time
+ *
+ * Implements the "lookup" algorithm by J. Keiser and D. Lemire,
+ * Validating UTF-8 in less than one instruction per byte,
+ * Software: Practice and Experience 51(5), 2021, 950-964,
+ * doi:10.1002/spe.2940.
+ *
+ * Each pair of consecutive bytes is classified by three 16-entry lookup
+ * tables (indexed by the high nibble of the first byte, its low nibble,
+ * and the high nibble of the second byte); the bitwise AND of the results
+ * is nonzero for an invalid pair. Missing and excess continuation bytes
+ * of 3- and 4-byte sequences are detected separately.
+ *
+ * Call only if stri__utf8_has_avx2()
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+__attribute__((target("avx2")))
+static bool stri__utf8_is_valid_avx2(const char* s, R_len_t n)
+{
+    const __m256i byte_1_high_tab = STRI__UTF8_LOOKUP16(
+        // 0_______ ________ <ASCII in byte 1>
+        STRI__UTF8_TOO_LONG, STRI__UTF8_TOO_LONG, STRI__UTF8_TOO_LONG, STRI__UTF8_TOO_LONG,
+        STRI__UTF8_TOO_LONG, STRI__UTF8_TOO_LONG, STRI__UTF8_TOO_LONG, STRI__UTF8_TOO_LONG,
+        // 10______ ________ <continuation in byte 1>
+        STRI__UTF8_TWO_CONTS, STRI__UTF8_TWO_CONTS, STRI__UTF8_TWO_CONTS, STRI__UTF8_TWO_CONTS,
+        // 1100____ ________ <two byte lead in byte 1>
+        STRI__UTF8_TOO_SHORT | STRI__UTF8_OVERLONG_2,
+        // 1101____ ________ <two byte lead in byte 1>
+        STRI__UTF8_TOO_SHORT,
+        // 1110____ ________ <three byte lead in byte 1>
+        STRI__UTF8_TOO_SHORT | STRI__UTF8_OVERLONG_3 | STRI__UTF8_SURROGATE,
+        // 1111____ ________ <four+ byte lead in byte 1>
+        STRI__UTF8_TOO_SHORT | STRI__UTF8_TOO_LARGE | STRI__UTF8_TOO_LARGE_1000 | STRI__UTF8_OVERLONG_4
+    );
+
+    const __m256i byte_1_low_tab = STRI__UTF8_LOOKUP16(
+        // ____0000 ________
+        STRI__UTF8_CARRY | STRI__UTF8_OVERLONG_3 | STRI__UTF8_OVERLONG_2 | STRI__UTF8_OVERLONG_4,
+        // ____0001 ________
+        STRI__UTF8_CARRY | STRI__UTF8_OVERLONG_2,
+        // ____001_ ________
+        STRI__UTF8_CARRY,
+        STRI__UTF8_CARRY,
+        // ____0100 ________
+        STRI__UTF8_CARRY | STRI__UTF8_TOO_LARGE,
+        // ____0101 ________
+        STRI__UTF8_CARRY | STRI__UTF8_TOO_LARGE | STRI__UTF8_TOO_LARGE_1000,
+        // ____011_ ________
+        STRI__UTF8_CARRY | STRI__UTF8_TOO_LARGE | STRI__UTF8_TOO_LARGE_1000,
+        STRI__UTF8_CARRY | STRI__UTF8_TOO_LARGE | STRI__UTF8_TOO_LARGE_1000,
+        // ____1___ ________
+        STRI__UTF8_CARRY | STRI__UTF8_TOO_LARGE | STRI__UTF8_TOO_LARGE_1000,
+        STRI__UTF8_CARRY | STRI__UTF8_TOO_LARGE | STRI__UTF8_TOO_LARGE_1000,
+        STRI__UTF8_CARRY | STRI__UTF8_TOO_LARGE | STRI__UTF8_TOO_LARGE_1000,
+        STRI__UTF8_CARRY | STRI__UTF8_TOO_LARGE | STRI__UTF8_TOO_LARGE_1000,
+        STRI__UTF8_CARRY | STRI__UTF8_TOO_LARGE | STRI__UTF8_TOO_LARGE_1000,
+        // ____1101 ________
+        STRI__UTF8_CARRY | STRI__UTF8_TOO_LARGE | STRI__UTF8_TOO_LARGE_1000 | STRI__UTF8_SURROGATE,
+        STRI__UTF8_CARRY | STRI__UTF8_TOO_LARGE | STRI__UTF8_TOO_LARGE_1000,
+        STRI__UTF8_CARRY | STRI__UTF8_TOO_LARGE | STRI__UTF8_TOO_LARGE_1000
+    );
+
+    const __m256i byte_2_high_tab = STRI__UTF8_LOOKUP16(
+        // ________ 0_______ <ASCII in byte 2>
+        STRI__UTF8_TOO_SHORT, STRI__UTF8_TOO_SHORT, STRI__UTF8_TOO_SHORT, STRI__UTF8_TOO_SHORT,
+        STRI__UTF8_TOO_SHORT, STRI__UTF8_TOO_SHORT, STRI__UTF8_TOO_SHORT, STRI__UTF8_TOO_SHORT,
+        // ________ 1000____
+        STRI__UTF8_TOO_LONG | STRI__UTF8_OVERLONG_2 | STRI__UTF8_TWO_CONTS | STRI__UTF8_OVERLONG_3 | STRI__UTF8_TOO_LARGE_1000 | STRI__UTF8_OVERLONG_4,
+        // ________ 1001____
+        STRI__UTF8_TOO_LONG | STRI__UTF8_OVERLONG_2 | STRI__UTF8_TWO_CONTS | STRI__UTF8_OVERLONG_3 | STRI__UTF8_TOO_LARGE,
+        // ________ 101_____
+        STRI__UTF8_TOO_LONG | STRI__UTF8_OVERLONG_2 | STRI__UTF8_TWO_CONTS | STRI__UTF8_SURROGATE | STRI__UTF8_TOO_LARGE,
+        STRI__UTF8_TOO_LONG | STRI__UTF8_OVERLONG_2 | STRI__UTF8_TWO_CONTS | STRI__UTF8_SURROGATE | STRI__UTF8_TOO_LARGE,
+        // ________ 11______
+        STRI__UTF8_TOO_SHORT, STRI__UTF8_TOO_SHORT, STRI__UTF8_TOO_SHORT, STRI__UTF8_TOO_SHORT
+    );
+
+    // a lead byte of a 2-, 3-, or 4-byte sequence in the last 3 positions
+    const __m256i max_complete = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        (char)(0xF0-1), (char)(0xE0-1), (char)(0xC0-1)
+    );
+
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+
+    __m256i prev_input = zero;
+    __m256i prev_incomplete = zero;
+    __m256i error = zero;
+
+    char tail[32];
+    R_len_t i = 0;
+    while (true) {
+        __m256i input;
+        if (i+32 <= n) {
+            input = _mm256_loadu_si256((const __m256i*)(s+i));
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(input, zero)) != 0)
+                return false;  // NUL byte
+        }
+        else {
+            // the remaining bytes, padded with NULs
+            // (so that any incomplete sequence at the end is reported)
+            memset(tail, 0, 32);
+            memcpy(tail, s+i, n-i);
+            input = _mm256_loadu_si256((const __m256i*)tail);
+            unsigned int nul_mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(input, zero));
+            if ((nul_mask & ((1u<<(n-i))-1u)) != 0)
+                return false;  // NUL byte
+        }
+
+        if (_mm256_movemask_epi8(input) == 0) {
+            // ASCII only; but the previous block could end prematurely
+            error = _mm256_or_si256(error, prev_incomplete);
+        }
+        else {
+            __m256i prev1 = STRI__UTF8_PREV(input, prev_input, 1);
+            __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_tab,
+                _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+            __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_tab,
+                _mm256_and_si256(prev1, low_nibble));
+            __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_tab,
+                _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+            __m256i special_cases = _mm256_and_si256(
+                _mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+            // must be the 2nd or 3rd continuation byte of a 3- or 4-byte sequence
+            __m256i prev2 = STRI__UTF8_PREV(input, prev_input, 2);
+            __m256i prev3 = STRI__UTF8_PREV(input, prev_input, 3);
+            __m256i must23 = _mm256_or_si256(
+                _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0-0x80))),
+                _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0-0x80))));
+            __m256i must23_80 = _mm256_and_si256(must23, _mm256_set1_epi8((char)0x80));
+
+            error = _mm256_or_si256(error, _mm256_xor_si256(must23_80, special_cases));
+            prev_incomplete = _mm256_subs_epu8(input, max_complete);
+        }
+
+        if (!_mm256_testz_si256(error, error))
+            return false;
+
+        if (i+32 > n)
+            break;  // the last (padded) block has just been processed
+
+        prev_input = input;
+        i += 32;
+    }
+
+    return true;
+}
+#endif
+
+
+/** Check if a string is valid UTF-8
+ *
+ * Uses AVX2 (if supported by the CPU) or skips ASCII-only
+ * blocks with SSE2 and validates the remaining ones code point
+ * by code point. Strings with NUL bytes are considered invalid.
+ *
+ * @param s string
+ * @param n number of bytes
+ * @return whether s is well-formed
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+bool stri__utf8_is_valid(const char* s, R_len_t n)
+{
+#ifdef STRI__UTF8_VALIDATE_AVX2
+    if (stri__utf8_has_avx2())
+        return stri__utf8_is_valid_avx2(s, n);
+#endif
+
+    R_len_t i = 0;
+
+#ifdef STRI__UTF8_VALIDATE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    while (i+16 <= n) {
+        __m128i input = _mm_loadu_si128((const __m128i*)(s+i));
+        unsigned int mask = (unsigned int)(_mm_movemask_epi8(input) |
+            _mm_movemask_epi8(_mm_cmpeq_epi8(input, zero)));
+        if (mask == 0) {
+            i += 16;  // ASCII only
+            continue;
+        }
+
+        // validate the rest of the block (and possibly a few more bytes)
+        R_len_t end = i+16;
+        i += (R_len_t)__builtin_ctz(mask);
+        UChar32 c;
+        while (i < end) {
+            if (s[i] == 0)
+                return false;
+
+            U8_NEXT(s, i, n, c);
+            if (c < 0)
+                return false;
+        }
+    }
+#endif
+
+    return stri__utf8_is_valid_scalar(s, i, n);
+}
+
+
+/** Check if a string is valid ASCII
+ *
+ * @param s string
+ * @param n number of bytes
+ * @return whether all bytes are in [1, 127]
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+bool stri__ascii_is_valid(const char* s, R_len_t n)
+{
+    R_len_t i = 0;
+
+#ifdef STRI__UTF8_VALIDATE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; i+16 <= n; i += 16) {
+        __m128i input = _mm_loadu_si128((const __m128i*)(s+i));
+        if ((_mm_movemask_epi8(input) | _mm_movemask_epi8(_mm_cmpeq_epi8(input, zero))) != 0)
+            return false;
+    }
+#endif
+
+    for (; i < n; ++i) {
+        if (!U8_IS_SINGLE(s[i]) || s[i] == 0) // i.e., 0 < c <= 127
+            return false;
+    }
+    return true;
+}
+
+
+#ifdef STRI__UTF8_VALIDATE_AVX2
+/** Count the code points in a UTF-8 string [AVX2]
+ *
+ * @param s string
+ * @param n number of bytes
+ * @param i [in/out] where to start; where the counting stopped
+ * @return number of non-continuation bytes in s[i..i'-1]
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+__attribute__((target("avx2")))
+static R_len_t stri__utf8_count_avx2(const char* s, R_len_t n, R_len_t& i)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i last_cont = _mm256_set1_epi8((char)0xBF);
+    R_len_t count = 0;
+    while (i+32 <= n) {
+        // count in byte-sized accumulators, at most 255 times
+        __m256i acc = zero;
+        R_len_t nblocks = std::min((n-i)/32, (R_len_t)255);
+        for (R_len_t k = 0; k < nblocks; ++k, i += 32) {
+            __m256i input = _mm256_loadu_si256((const __m256i*)(s+i));
+            // continuation bytes are 0x80..0xBF, i.e., -128..-65 as signed chars
+            acc = _mm256_sub_epi8(acc, _mm256_cmpgt_epi8(input, last_cont));
+        }
+        __m256i sums = _mm256_sad_epu8(acc, zero);
+        count += (R_len_t)(_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+            _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3));
+    }
+    return count;
+}
+#endif
+
+
+/** Count the code points in a valid UTF-8 string
+ *
+ * Counts the bytes which are not continuation bytes,
+ * 32 (AVX2) or 16 (SSE2) bytes at a time.
+ * The input is not validated; see \code{stri__utf8_is_valid}.
+ *
+ * @param s string
+ * @param n number of bytes
+ * @return number of code points
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+R_len_t stri__utf8_count_codepoints(const char* s, R_len_t n)
+{
+    R_len_t i = 0;
+    R_len_t count = 0;
+
+#ifdef STRI__UTF8_VALIDATE_AVX2
+    if (stri__utf8_has_avx2())
+        count += stri__utf8_count_avx2(s, n, i);
+#endif
+
+#ifdef STRI__UTF8_VALIDATE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i last_cont = _mm_set1_epi8((char)0xBF);
+    while (i+16 <= n) {
+        // count in byte-sized accumulators, at most 255 times
+        __m128i acc = zero;
+        R_len_t nblocks = std::min((n-i)/16, (R_len_t)255);
+        for (R_len_t k = 0; k < nblocks; ++k, i += 16) {
+            __m128i input = _mm_loadu_si128((const __m128i*)(s+i));
+            acc = _mm_sub_epi8(acc, _mm_cmpgt_epi8(input, last_cont));
+        }
+        __m128i sums = _mm_sad_epu8(acc, zero);
+        count += (R_len_t)(_mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4));
+    }
+#endif
+
+    for (; i < n; ++i) {
+        if (!U8_IS_TRAIL(s[i]))
+            ++count;
+    }
+    return count;
+}
@@ -63,6 +63,7 @@ SEXP stri_duplicated_any(SEXP str, SEXP fromLast=Rf_ScalarLogical(FALSE),
 
 // ICU_settings.cpp:
 SEXP stri_info();
+SEXP stri_options(SEXP opts=R_NilValue);
 
 // escape.cpp
 SEXP stri_escape_unicode(SEXP str);
@@ -120,6 +121,7 @@ SEXP stri_stats_latex(SEXP str);
 // trans_transliterate.cpp:
 SEXP stri_trans_list();
 SEXP stri_trans_general(SEXP str, SEXP id, SEXP rules, SEXP forward);
+SEXP stri_trans_precompile(SEXP id, SEXP rules, SEXP forward);
 
 // utils.cpp
 SEXP stri_list2matrix(SEXP x, SEXP byrow=Rf_ScalarLogical(FALSE),
@@ -136,9 +138,20 @@ SEXP stri_enc_toutf8(SEXP str, SEXP is_unknown_8bit=Rf_ScalarLogical(FALSE),
 SEXP stri_enc_toascii(SEXP str);
 
 
+// files.cpp:
+SEXP stri_read_lines_open(SEXP encoding=R_NilValue, SEXP fname=R_NilValue);
+SEXP stri_read_lines_push(SEXP reader, SEXP data, SEXP final=Rf_ScalarLogical(FALSE));
+SEXP stri_read_raw_file(SEXP fname);
+SEXP stri_write_lines_open(SEXP encoding=R_NilValue, SEXP sep=Rf_mkString("\n"),
+    SEXP bufsize=Rf_ScalarInteger(4194304), SEXP fname=R_NilValue,
+    SEXP append=Rf_ScalarLogical(FALSE));
+SEXP stri_write_lines_push(SEXP writer, SEXP str, SEXP final=Rf_ScalarLogical(FALSE));
+
+
 // encoding_detection.cpp:
 SEXP stri_enc_detect2(SEXP str, SEXP loc=R_NilValue);
-SEXP stri_enc_detect(SEXP str, SEXP filter_angle_brackets=Rf_ScalarLogical(FALSE));
+SEXP stri_enc_detect(SEXP str, SEXP filter_angle_brackets=Rf_ScalarLogical(FALSE),
+    SEXP sample_size=Rf_ScalarInteger(NA_INTEGER));
 SEXP stri_enc_isascii(SEXP str);
 SEXP stri_enc_isutf8(SEXP str);
 SEXP stri_enc_isutf16le(SEXP str);
@@ -239,6 +252,13 @@ SEXP stri_detect_fixed(SEXP str, SEXP pattern,
     SEXP negate=Rf_ScalarLogical(FALSE), SEXP max_count=Rf_ScalarInteger(-1),
     SEXP opts_fixed=R_NilValue);
 SEXP stri_count_fixed(SEXP str, SEXP pattern, SEXP opts_fixed=R_NilValue);
+SEXP stri_detect_dict(SEXP str, SEXP dict,
+    SEXP simplify=Rf_ScalarLogical(TRUE), SEXP opts_fixed=R_NilValue);
+SEXP stri_count_dict(SEXP str, SEXP dict, SEXP opts_fixed=R_NilValue);
+SEXP stri_replace_all_dict(SEXP str, SEXP dict, SEXP replacement,
+    SEXP opts_fixed=R_NilValue);
+SEXP stri_in_fixed(SEXP str, SEXP table, SEXP nomatch=Rf_ScalarInteger(NA_INTEGER),
+    SEXP normalize=Rf_ScalarLogical(FALSE), SEXP opts_fixed=R_NilValue);
 SEXP stri_locate_all_fixed(
     SEXP str, SEXP pattern,
     SEXP omit_no_match=Rf_ScalarLogical(FALSE), SEXP opts_fixed=R_NilValue,
@@ -308,7 +328,8 @@ SEXP stri_locate_last_regex(
 );
 SEXP stri_replace_all_regex(
     SEXP str, SEXP pattern, SEXP replacement,
-    SEXP vectorize_all=Rf_ScalarLogical(FALSE), SEXP opts_regex=R_NilValue
+    SEXP vectorize_all=Rf_ScalarLogical(FALSE), SEXP opts_regex=R_NilValue,
+    SEXP single_pass=Rf_ScalarLogical(FALSE)
 );
 SEXP stri_replace_first_regex(
     SEXP str, SEXP pattern, SEXP replacement,
@@ -0,0 +1,873 @@
+/* This file is part of the 'stringi' project.
+ * Copyright (c) 2013-2026, Marek Gagolewski <https://www.gagolewski.com/>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "stri_stringi.h"
+#include "stri_container_utf8.h"
+#include "stri_ucnv.h"
+#include <deque>
+#include <string>
+#include <utility>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#define STRI__FILES_POSIX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#define STRI__READ_LINES_UBUFSIZE 65536
+#define STRI__WRITE_LINES_CBUFSIZE 65536
+
+
+/**
+ * A read-only memory mapping of a regular file
+ *
+ * Memory mapping is only available on POSIX systems; elsewhere,
+ * or if the file is not a regular one (e.g., a pipe or a device),
+ * open() fails, and the caller should fall back to R connections.
+ *
+ * Accessing the mapped pages beyond the end of a file that has been
+ * truncated after it was mapped raises SIGBUS; the file is kept open
+ * so that hasSize() can be checked before reading a part of it
+ * which may have been affected.
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriFileMap {
+
+private:
+
+    const char* m_data;
+    size_t m_size;
+    bool m_isopen;
+    int m_fd;
+
+    StriFileMap(const StriFileMap&); // not copyable
+    StriFileMap& operator=(const StriFileMap&);
+
+public:
+
+    StriFileMap() {
+        m_data = NULL;
+        m_size = 0;
+        m_isopen = false;
+        m_fd = -1;
+    }
+
+    ~StriFileMap() {
+        close();
+    }
+
+    /** Map a file
+     *
+     * @param fname file name (in the native encoding)
+     * @return whether the file has been mapped
+     */
+    bool open(const char* fname)
+    {
+        close();
+#ifdef STRI__FILES_POSIX
+        int fd = ::open(fname, O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            ::close(fd);
+            return false;
+        }
+
+        m_size = (size_t)st.st_size;
+        if (m_size > 0) {
+            void* addr = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                m_size = 0;
+                return false;
+            }
+#ifdef MADV_SEQUENTIAL
+            madvise(addr, m_size, MADV_SEQUENTIAL);
+#endif
+            m_data = (const char*)addr;
+        }
+        m_fd = fd;  // see hasSize()
+        m_isopen = true;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void close()
+    {
+#ifdef STRI__FILES_POSIX
+        if (m_data)
+            munmap((void*)m_data, m_size);
+        if (m_fd >= 0)
+            ::close(m_fd);
+#endif
+        m_data = NULL;
+        m_size = 0;
+        m_isopen = false;
+        m_fd = -1;
+    }
+
+    /** Is the (opened) file still at least the given number of bytes long?
+     *
+     * @param size number of bytes
+     * @return false if the file has been truncated in the meantime
+     */
+    bool hasSize(size_t size) const
+    {
+#ifdef STRI__FILES_POSIX
+        struct stat st;
+        return m_fd >= 0 && fstat(m_fd, &st) == 0 && (size_t)st.st_size >= size;
+#else
+        return false;
+#endif
+    }
+
+    /** Get the size of a regular file without mapping it
+     *
+     * @param fname file name (in the native encoding)
+     * @param size [out] file size
+     * @return false if the file cannot be mapped, see open()
+     */
+    static bool getRegularFileSize(const char* fname, size_t& size)
+    {
+#ifdef STRI__FILES_POSIX
+        struct stat st;
+        if (::stat(fname, &st) != 0 || !S_ISREG(st.st_mode))
+            return false;
+        size = (size_t)st.st_size;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool isOpen() const { return m_isopen; }
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+};
+
+
+/**
+ * An incremental text line reader: decodes consecutive blocks of bytes
+ * in a given encoding and splits them into text lines
+ * (like stri_split_lines1 applied on the whole text).
+ *
+ * The converter state and the incomplete last line are carried over
+ * between blocks, so multibyte sequences and CR LF pairs
+ * may span block boundaries.
+ *
+ * The blocks are either pushed by the caller or taken from
+ * a memory-mapped file.  Valid UTF-8 input is copied as-is,
+ * bypassing the ICU converters.
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriLineReader {
+
+private:
+
+    std::string m_encoding;    // owns the name used by m_ucnv_from
+    StriUcnv m_ucnv_from;      // input encoding -> UTF-16
+    StriUcnv m_ucnv_to;        // UTF-16 -> UTF-8
+    UChar m_ubuf[STRI__READ_LINES_UBUFSIZE];
+    char m_cbuf[3*STRI__READ_LINES_UBUFSIZE];
+    std::string m_buf;         // decoded UTF-8 text that is not yet a complete line
+    R_len_t m_scanned;         // m_buf[0..m_scanned-1] has no line breaks
+    double m_nlines;           // number of lines produced so far
+    bool m_finished;
+    bool m_isutf8;             // is the input encoding UTF-8?
+    StriFileMap m_map;         // input file, if mapped
+    size_t m_map_offset;       // how many bytes of m_map have been consumed
+
+
+    /** Decode a block of bytes and append it to m_buf [with ICU] */
+    void decode_ucnv(const char* s, R_len_t n, bool flush)
+    {
+        UConverter* uconv_from = m_ucnv_from.getConverter(true /*register_callbacks*/);
+        UConverter* uconv_to   = m_ucnv_to.getConverter(true /*register_callbacks*/);
+
+        const char* source = s;
+        const char* source_limit = s+n;
+        bool more;
+        do {
+            UErrorCode status = U_ZERO_ERROR;
+            UChar* utarget = m_ubuf;
+            ucnv_toUnicode(uconv_from, &utarget, m_ubuf+STRI__READ_LINES_UBUFSIZE,
+                &source, source_limit, NULL, flush, &status);
+            more = (status == U_BUFFER_OVERFLOW_ERROR);
+            if (more) status = U_ZERO_ERROR;
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+            // unpaired surrogates at the end of m_ubuf are kept in uconv_to
+            const UChar* usource = m_ubuf;
+            bool more_to;
+            do {
+                status = U_ZERO_ERROR;
+                char* ctarget = m_cbuf;
+                ucnv_fromUnicode(uconv_to, &ctarget, m_cbuf+3*STRI__READ_LINES_UBUFSIZE,
+                    &usource, utarget, NULL, flush && !more, &status);
+                more_to = (status == U_BUFFER_OVERFLOW_ERROR);
+                if (more_to) status = U_ZERO_ERROR;
+                STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+                m_buf.append(m_cbuf, (size_t)(ctarget-m_cbuf));
+            } while (more_to);
+        } while (more);
+    }
+
+
+    /** Decode a block of bytes and append it to m_buf */
+    void decode(const char* s, R_len_t n, bool flush)
+    {
+        if (!m_isutf8) {
+            decode_ucnv(s, n, flush);
+            return;
+        }
+
+        // UTF-8 -> UTF-8: the converter is only needed for invalid input
+        // (substitutions, warnings) and for sequences that span
+        // block boundaries, which it holds in its state
+        UConverter* uconv_from = m_ucnv_from.getConverter(true /*register_callbacks*/);
+        R_len_t i = 0;
+        UErrorCode status = U_ZERO_ERROR;
+        while (i < n && ucnv_toUCountPending(uconv_from, &status) > 0) {
+            decode_ucnv(s+i, 1, flush && i == n-1);  // complete the pending sequence
+            ++i;
+            status = U_ZERO_ERROR;
+        }
+
+        // leave an incomplete sequence at the end of the block to the converter
+        R_len_t cut = n;
+        if (!flush && cut > i) {
+            R_len_t p = cut-1;
+            while (p > i && p > cut-4 && U8_IS_TRAIL(s[p])) --p;
+            if (U8_IS_LEAD(s[p]) && U8_COUNT_TRAIL_BYTES((uint8_t)s[p])+1 > cut-p)
+                cut = p;
+        }
+
+        if (stri__utf8_is_valid(s+i, cut-i)) {
+            m_buf.append(s+i, (size_t)(cut-i));
+            if (cut < n || flush) decode_ucnv(s+cut, n-cut, flush);
+        }
+        else
+            decode_ucnv(s+i, n-i, flush);
+    }
+
+
+public:
+
+    StriLineReader(const char* encoding)
+        : m_encoding(encoding?encoding:""),
+          m_ucnv_from(encoding?m_encoding.c_str():NULL),
+          m_ucnv_to("UTF-8")
+    {
+        m_scanned = 0;
+        m_nlines = 0.0;
+        m_finished = false;
+        m_map_offset = 0;
+        m_ucnv_from.getConverter(true); // fail early on unsupported encodings
+        m_ucnv_to.getConverter(true);
+        m_isutf8 = m_ucnv_from.isUTF8();
+    }
+
+
+    /** Read the input from a memory-mapped file
+     *
+     * @param fname file name (in the native encoding)
+     * @return whether the file has been mapped; if not, use push()
+     */
+    bool openFile(const char* fname)
+    {
+        m_map_offset = 0;
+        return m_map.open(fname);
+    }
+
+
+    /** Size of the memory-mapped file (if opened) */
+    size_t getFileSize() const { return m_map.size(); }
+
+
+    /** Decode the next block of the memory-mapped file
+     *
+     * @param nbytes block size
+     * @param final whether to consume the rest of the file
+     * @return character vector, see push()
+     */
+    SEXP pushFromFile(size_t nbytes, bool final)
+    {
+        if (!m_map.isOpen())
+            throw StriException(MSG__INCORRECT_INTERNAL_ARG);
+
+        size_t remaining = m_map.size()-m_map_offset;
+        if (final || nbytes > remaining) nbytes = remaining;
+        if (nbytes > (size_t)INT_MAX) nbytes = (size_t)INT_MAX;  // R_len_t
+        if (!m_map.hasSize(m_map_offset+nbytes))  // avoid SIGBUS
+            throw StriException(MSG__FILE_TRUNCATED);
+        const char* s = m_map.data()+m_map_offset;
+        m_map_offset += nbytes;
+        final = final && m_map_offset == m_map.size();
+
+        SEXP ret = push(s, (R_len_t)nbytes, final);
+        if (final) m_map.close();
+        return ret;
+    }
+
+
+    /** Decode the next block of bytes and get the text lines it completes
+     *
+     * @param s block of bytes
+     * @param n number of bytes
+     * @param final is this the last block?
+     * @return character vector
+     */
+    SEXP push(const char* s, R_len_t n, bool final)
+    {
+        if (m_finished)
+            throw StriException(MSG__INCORRECT_INTERNAL_ARG);
+
+        decode(s, n, final);
+
+        // split into lines; see stri_split_lines1
+        const char* str_cur_s = m_buf.data();
+        R_len_t str_cur_n = (R_len_t)m_buf.size();
+        std::deque< std::pair<R_len_t, R_len_t> > occurrences;
+        R_len_t start = 0;
+        R_len_t j = m_scanned;
+        while (j < str_cur_n) {
+            uint8_t c = (uint8_t)str_cur_s[j];
+            R_len_t nl = 0;  // length of the newline sequence
+            if (c >= ASCII_LF && c <= ASCII_CR) {  // LF, VT, FF, CR
+                nl = 1;
+                if (c == ASCII_CR) {
+                    if (j+1 < str_cur_n) {
+                        if (str_cur_s[j+1] == ASCII_LF) nl = 2;
+                    }
+                    else if (!final)
+                        break;  // wait for a possible LF in the next block
+                }
+            }
+            else if (c == 0xC2) {  // NEL (U+0085)
+                if (j+1 < str_cur_n && (uint8_t)str_cur_s[j+1] == 0x85) nl = 2;
+            }
+            else if (c == 0xE2) {  // LS (U+2028), PS (U+2029)
+                if (j+2 < str_cur_n && (uint8_t)str_cur_s[j+1] == 0x80 &&
+                        ((uint8_t)str_cur_s[j+2] == 0xA8 || (uint8_t)str_cur_s[j+2] == 0xA9))
+                    nl = 3;
+            }
+
+            if (nl == 0) {
+                ++j;
+                continue;
+            }
+
+            occurrences.push_back(std::pair<R_len_t, R_len_t>(start, j));
+            j += nl;
+            start = j;
+        }
+
+        if (final) {
+            // the last line is not terminated by a newline or the text is empty
+            if (start < str_cur_n || (m_nlines == 0.0 && occurrences.empty()))
+                occurrences.push_back(std::pair<R_len_t, R_len_t>(start, str_cur_n));
+            m_finished = true;
+        }
+
+        SEXP ans;
+        PROTECT(ans = Rf_allocVector(STRSXP, (R_len_t)occurrences.size()));
+        std::deque< std::pair<R_len_t, R_len_t> >::iterator iter = occurrences.begin();
+        for (R_len_t k = 0; iter != occurrences.end(); ++iter, ++k) {
+            std::pair<R_len_t, R_len_t> curoccur = *iter;
+            SET_STRING_ELT(ans, k,
+                Rf_mkCharLenCE(str_cur_s+curoccur.first, curoccur.second-curoccur.first, CE_UTF8));
+        }
+        UNPROTECT(1);
+
+        m_nlines += (double)occurrences.size();
+        m_scanned = j-start;
+        m_buf.erase(0, (size_t)start);
+        if (m_finished) std::string().swap(m_buf);
+        return ans;
+    }
+};
+
+
+/** Finalizer for the external pointers created by stri_read_lines_open
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static void stri__read_lines_finalizer(SEXP reader)
+{
+    StriLineReader* r = (StriLineReader*)R_ExternalPtrAddr(reader);
+    if (r) {
+        delete r;
+        R_ClearExternalPtr(reader);
+    }
+}
+
+
+/** Create a new incremental text line reader
+ *
+ * @param encoding input encoding
+ * @param fname \code{NULL} or a file name; if given and the file
+ *    can be memory-mapped, the reader takes its input from there,
+ *    and the resulting object has the \code{size} attribute set
+ * @return external pointer, see stri_read_lines_push
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+SEXP stri_read_lines_open(SEXP encoding, SEXP fname)
+{
+    const char* selected_encoding = stri__prepare_arg_enc(encoding, "encoding", true); /* this is R_alloc'ed */
+    const char* fname_val = NULL;
+    if (!Rf_isNull(fname)) {
+        PROTECT(fname = stri__prepare_arg_string_1(fname, "fname"));
+        if (STRING_ELT(fname, 0) == NA_STRING)
+            Rf_error(MSG__INCORRECT_NAMED_ARG, "fname");  // error() call allowed here
+        fname_val = R_ExpandFileName(Rf_translateChar(STRING_ELT(fname, 0)));
+        UNPROTECT(1);
+    }
+
+    StriLineReader* reader = NULL;
+    STRI__ERROR_HANDLER_BEGIN(0)
+    reader = new StriLineReader(selected_encoding);
+    bool mapped = (fname_val && reader->openFile(fname_val));
+
+    SEXP ret;
+    STRI__PROTECT(ret = R_MakeExternalPtr(reader, Rf_install("stri_read_lines"), R_NilValue));
+    R_RegisterCFinalizerEx(ret, stri__read_lines_finalizer, TRUE);
+    if (mapped)
+        Rf_setAttrib(ret, Rf_install("size"), Rf_ScalarReal((double)reader->getFileSize()));
+    reader = NULL;  // owned by ret now
+
+    STRI__UNPROTECT_ALL
+    return ret;
+    STRI__ERROR_HANDLER_END(
+        if (reader) {
+            delete reader;
+            reader = NULL;
+        }
+    )
+}
+
+
+/** Feed an incremental text line reader with the next block of bytes
+ *
+ * @param reader external pointer created by stri_read_lines_open
+ * @param data raw vector or, if the reader reads from a
+ *    memory-mapped file, the number of bytes to consume
+ * @param final single logical value; is this the last block?
+ * @return character vector with the text lines completed by this block
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+SEXP stri_read_lines_push(SEXP reader, SEXP data, SEXP final)
+{
+    if (TYPEOF(reader) != EXTPTRSXP || R_ExternalPtrTag(reader) != Rf_install("stri_read_lines"))
+        Rf_error(MSG__INCORRECT_INTERNAL_ARG);  // error() call allowed here
+    StriLineReader* r = (StriLineReader*)R_ExternalPtrAddr(reader);
+    if (!r)
+        Rf_error(MSG__INCORRECT_INTERNAL_ARG);  // error() call allowed here
+    bool final_val = stri__prepare_arg_logical_1_notNA(final, "final");
+
+    if (TYPEOF(data) == REALSXP || TYPEOF(data) == INTSXP) {  // memory-mapped file
+        double nbytes = stri__prepare_arg_double_1_notNA(data, "data");
+        if (nbytes < 0) Rf_error(MSG__INCORRECT_NAMED_ARG, "data");  // error() call allowed here
+
+        STRI__ERROR_HANDLER_BEGIN(0)
+        SEXP ret;
+        STRI__PROTECT(ret = r->pushFromFile((size_t)nbytes, final_val));
+        STRI__UNPROTECT_ALL
+        return ret;
+        STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
+    }
+
+    PROTECT(data = stri__prepare_arg_raw(data, "data"));
+
+    STRI__ERROR_HANDLER_BEGIN(1)
+    SEXP ret;
+    STRI__PROTECT(ret = r->push((const char*)RAW(data), LENGTH(data), final_val));
+    STRI__UNPROTECT_ALL
+    return ret;
+    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
+}
+
+
+/** Read a whole file into a raw vector via a memory mapping
+ *
+ * @param fname file name
+ * @return raw vector or \code{NULL} if the file cannot be mapped
+ *    (e.g., it is not a regular file or memory mapping is not supported),
+ *    in which case the caller should use R connections
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+SEXP stri_read_raw_file(SEXP fname)
+{
+    PROTECT(fname = stri__prepare_arg_string_1(fname, "fname"));
+    if (STRING_ELT(fname, 0) == NA_STRING)
+        Rf_error(MSG__INCORRECT_NAMED_ARG, "fname");  // error() call allowed here
+    const char* fname_val = R_ExpandFileName(Rf_translateChar(STRING_ELT(fname, 0)));
+
+    STRI__ERROR_HANDLER_BEGIN(1)
+    // allocate the result before mapping the file: Rf_allocVector
+    // may longjmp, and then the mapping would never be released
+    size_t size;
+    if (!StriFileMap::getRegularFileSize(fname_val, size)) {
+        STRI__UNPROTECT_ALL
+        return R_NilValue;
+    }
+
+    SEXP ret;
+    STRI__PROTECT(ret = Rf_allocVector(RAWSXP, (R_xlen_t)size));
+
+    StriFileMap map;
+    if (!map.open(fname_val) || map.size() != size) {
+        // the file has changed in the meantime
+        STRI__UNPROTECT_ALL
+        return R_NilValue;
+    }
+
+    if (size > 0)
+        memcpy(RAW(ret), map.data(), size);
+    map.close();
+    STRI__UNPROTECT_ALL
+    return ret;
+    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
+}
+
+
+/**
+ * A buffered text line writer: encodes consecutive batches of strings
+ * (each followed by a line separator) into a given encoding
+ *
+ * The same converter is used for all the batches, so that, e.g.,
+ * a byte order mark is only emitted once.  Valid UTF-8 strings are
+ * copied as-is if the output encoding is UTF-8.
+ *
+ * The encoded bytes are either returned to the caller (which writes them
+ * to an R connection) or, on POSIX systems, written directly to a file
+ * whenever the buffer grows beyond a given size.
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriLineWriter {
+
+private:
+
+    std::string m_encoding;    // owns the name used by m_ucnv_to
+    StriUcnv m_ucnv_to;        // UTF-16 -> output encoding
+    char m_cbuf[STRI__WRITE_LINES_CBUFSIZE];
+    std::string m_sep;         // line separator (UTF-8)
+    std::string m_out;         // encoded bytes not yet written
+    size_t m_bufsize;
+    bool m_isutf8;             // is the output encoding UTF-8?
+    bool m_finished;
+    std::string m_fname;
+    int m_fd;                  // output file descriptor or -1
+
+
+    /** Encode a UTF-16 buffer and append it to m_out [with ICU] */
+    void encode_ucnv(const UChar* s, int32_t n, bool flush)
+    {
+        UConverter* uconv_to = m_ucnv_to.getConverter(true /*register_callbacks*/);
+
+        const UChar* source = s;
+        bool more;
+        do {
+            UErrorCode status = U_ZERO_ERROR;
+            char* target = m_cbuf;
+            ucnv_fromUnicode(uconv_to, &target, m_cbuf+STRI__WRITE_LINES_CBUFSIZE,
+                &source, s+n, NULL, flush, &status);
+            more = (status == U_BUFFER_OVERFLOW_ERROR);
+            if (more) status = U_ZERO_ERROR;
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            m_out.append(m_cbuf, (size_t)(target-m_cbuf));
+        } while (more);
+    }
+
+
+    /** Encode a UTF-8 string and append it to m_out */
+    void encode(const char* s, R_len_t n)
+    {
+        if (n <= 0) return;
+
+        if (m_isutf8 && stri__utf8_is_valid(s, n)) {
+            m_out.append(s, (size_t)n);
+            return;
+        }
+
+        UnicodeString u = UnicodeString::fromUTF8(StringPiece(s, n));
+        encode_ucnv(u.getBuffer(), u.length(), false);
+    }
+
+
+    /** Write the contents of m_out to the output file */
+    void writeFile()
+    {
+#ifdef STRI__FILES_POSIX
+        const char* p = m_out.data();
+        size_t n = m_out.size();
+        while (n > 0) {
+            ssize_t k = ::write(m_fd, p, n);
+            if (k < 0) {
+                if (errno == EINTR) continue;
+                throw StriException(MSG__FILE_WRITE_ERROR, m_fname.c_str());
+            }
+            p += k;
+            n -= (size_t)k;
+        }
+#endif
+        m_out.clear();
+    }
+
+
+public:
+
+    StriLineWriter(const char* encoding, const char* sep, R_len_t sep_n, size_t bufsize)
+        : m_encoding(encoding?encoding:""),
+          m_ucnv_to(encoding?m_encoding.c_str():NULL),
+          m_sep(sep, (size_t)sep_n)
+    {
+        m_bufsize = bufsize;
+        m_finished = false;
+        m_fd = -1;
+        m_ucnv_to.getConverter(true); // fail early on unsupported encodings
+        m_isutf8 = m_ucnv_to.isUTF8();
+    }
+
+
+    ~StriLineWriter()
+    {
+        closeFileNoThrow();  // destructors must not throw
+    }
+
+
+    /** Write the output directly to a file
+     *
+     * @param fname file name (in the native encoding)
+     * @param append whether to append to the file instead of truncating it
+     * @return whether the file has been opened; if not, the caller
+     *    should write the data returned by push() itself
+     */
+    bool openFile(const char* fname, bool append)
+    {
+        closeFile();
+#ifdef STRI__FILES_POSIX
+        m_fd = ::open(fname, O_WRONLY|O_CREAT|(append?O_APPEND:O_TRUNC), 0666);
+        if (m_fd < 0) return false;
+        m_fname = fname;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+
+    /** Close the output file (if any)
+     *
+     * @return false if closing the file failed
+     */
+    bool closeFileNoThrow()
+    {
+#ifdef STRI__FILES_POSIX
+        if (m_fd >= 0) {
+            int fd = m_fd;
+            m_fd = -1;
+            return (::close(fd) == 0);
+        }
+#endif
+        return true;
+    }
+
+
+    /** Close the output file (if any); throws if closing it failed */
+    void closeFile()
+    {
+        if (!closeFileNoThrow())
+            throw StriException(MSG__FILE_WRITE_ERROR, m_fname.c_str());
+    }
+
+
+    /** Encode the next batch of text lines
+     *
+     * @param str character vector
+     * @param final is this the last batch?
+     * @return raw vector with the encoded lines or,
+     *    if the output goes to a file, \code{NULL}
+     */
+    SEXP push(SEXP str, bool final)
+    {
+        if (m_finished)
+            throw StriException(MSG__INCORRECT_INTERNAL_ARG);
+
+        R_len_t str_length = LENGTH(str);
+        StriContainerUTF8 str_cont(str, str_length);
+        for (R_len_t i = 0; i < str_length; ++i) {
+            if (str_cont.isNA(i))
+                throw StriException(MSG__ARG_EXPECTED_NOT_NA, "str");
+
+            encode(str_cont.get(i).c_str(), str_cont.get(i).length());
+            encode(m_sep.data(), (R_len_t)m_sep.size());
+
+            if (m_fd >= 0 && m_out.size() >= m_bufsize)
+                writeFile();
+        }
+
+        if (final) {
+            encode_ucnv(NULL, 0, true);
+            m_finished = true;
+        }
+
+        if (m_fd >= 0) {
+            if (final) {
+                writeFile();
+                closeFile();
+            }
+            return R_NilValue;
+        }
+
+        SEXP ret;
+        PROTECT(ret = Rf_allocVector(RAWSXP, (R_xlen_t)m_out.size()));
+        if (m_out.size() > 0)
+            memcpy(RAW(ret), m_out.data(), m_out.size());
+        m_out.clear();
+        if (m_finished) std::string().swap(m_out);
+        UNPROTECT(1);
+        return ret;
+    }
+};
+
+
+/** Finalizer for the external pointers created by stri_write_lines_open
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static void stri__write_lines_finalizer(SEXP writer)
+{
+    StriLineWriter* w = (StriLineWriter*)R_ExternalPtrAddr(writer);
+    if (w) {
+        delete w;  // closes the file, ignoring any errors
+        R_ClearExternalPtr(writer);
+    }
+}
+
+
+/** Create a new buffered text line writer
+ *
+ * @param encoding output encoding
+ * @param sep single string, line separator
+ * @param bufsize single number, buffer size in bytes
+ * @param fname \code{NULL} or a file name; if given and the file
+ *    can be opened directly, the writer sends its output there,
+ *    and the resulting object has the \code{file} attribute set
+ * @param append single logical value; whether to append to the file
+ * @return external pointer, see stri_write_lines_push
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+SEXP stri_write_lines_open(SEXP encoding, SEXP sep, SEXP bufsize, SEXP fname, SEXP append)
+{
+    const char* selected_encoding = stri__prepare_arg_enc(encoding, "encoding", true); /* this is R_alloc'ed */
+    bool append_val = stri__prepare_arg_logical_1_notNA(append, "append");
+    double bufsize_val = stri__prepare_arg_double_1_notNA(bufsize, "bufsize");
+    if (bufsize_val < 1.0)
+        Rf_error(MSG__INCORRECT_NAMED_ARG, "bufsize");  // error() call allowed here
+    const char* fname_val = NULL;
+    if (!Rf_isNull(fname)) {
+        PROTECT(fname = stri__prepare_arg_string_1(fname, "fname"));
+        if (STRING_ELT(fname, 0) == NA_STRING)
+            Rf_error(MSG__INCORRECT_NAMED_ARG, "fname");  // error() call allowed here
+        fname_val = R_ExpandFileName(Rf_translateChar(STRING_ELT(fname, 0)));
+        UNPROTECT(1);
+    }
+    PROTECT(sep = stri__prepare_arg_string_1(sep, "sep"));
+    if (STRING_ELT(sep, 0) == NA_STRING)
+        Rf_error(MSG__ARG_EXPECTED_NOT_NA, "sep");  // error() call allowed here
+
+    StriLineWriter* writer = NULL;
+    STRI__ERROR_HANDLER_BEGIN(1)
+    StriContainerUTF8 sep_cont(sep, 1);
+    writer = new StriLineWriter(selected_encoding,
+        sep_cont.get(0).c_str(), sep_cont.get(0).length(), (size_t)bufsize_val);
+    bool opened = (fname_val && writer->openFile(fname_val, append_val));
+
+    SEXP ret;
+    STRI__PROTECT(ret = R_MakeExternalPtr(writer, Rf_install("stri_write_lines"), R_NilValue));
+    R_RegisterCFinalizerEx(ret, stri__write_lines_finalizer, TRUE);
+    if (opened)
+        Rf_setAttrib(ret, Rf_install("file"), Rf_ScalarLogical(TRUE));
+    writer = NULL;  // owned by ret now
+
+    STRI__UNPROTECT_ALL
+    return ret;
+    STRI__ERROR_HANDLER_END(
+        if (writer) {
+            delete writer;
+            writer = NULL;
+        }
+    )
+}
+
+
+/** Feed a buffered text line writer with the next batch of strings
+ *
+ * @param writer external pointer created by stri_write_lines_open
+ * @param str character vector
+ * @param final single logical value; is this the last batch?
+ * @return raw vector with the encoded text lines or, if the writer
+ *    sends its output directly to a file, \code{NULL}
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+SEXP stri_write_lines_push(SEXP writer, SEXP str, SEXP final)
+{
+    if (TYPEOF(writer) != EXTPTRSXP || R_ExternalPtrTag(writer) != Rf_install("stri_write_lines"))
+        Rf_error(MSG__INCORRECT_INTERNAL_ARG);  // error() call allowed here
+    StriLineWriter* w = (StriLineWriter*)R_ExternalPtrAddr(writer);
+    if (!w)
+        Rf_error(MSG__INCORRECT_INTERNAL_ARG);  // error() call allowed here
+    bool final_val = stri__prepare_arg_logical_1_notNA(final, "final");
+    PROTECT(str = stri__prepare_arg_string(str, "str"));
+
+    STRI__ERROR_HANDLER_BEGIN(1)
+    SEXP ret;
+    STRI__PROTECT(ret = w->push(str, final_val));
+    STRI__UNPROTECT_ALL
+    return ret;
+    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
+}
@@ -32,6 +32,7 @@
 #include "stri_stringi.h"
 #include "stri_ucnv.h"
 #include "stri_container_utf8.h"
+#include "stri_parallel.h"
 
 
 /**
@@ -91,6 +92,9 @@ R_len_t stri__numbytes_max(SEXP str)
  *
  * @version 1.6.3 (Marek Gagolewski, 2021-05-22)
  *    use stri__length_string for UTF-8
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    vectorised code point counting (via stri__length_string)
  */
 SEXP stri_length(SEXP str)
 {
@@ -410,12 +414,21 @@ int stri__width_char_with_context(UChar32 c, UChar32 p, bool& reset)
  *
  * @version 1.6.3 (Marek Gagolewski, 2021-05-22)
  *    extracted from stri_length
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    count the code points in valid strings with a vectorised kernel
  */
 int stri__length_string(const char* str_cur_s, int str_cur_n, int max_length)
 {
     // is string is in ASCII, then length == str_cur_n, but with
     // merely str_cur_s ptr we are unable to tell that here
 
+    // for valid UTF-8, the number of code points == the number of
+    // non-continuation bytes; the scalar loop below is used
+    // to report errors (or if max_length is given)
+    if (max_length == NA_INTEGER && stri__utf8_is_valid(str_cur_s, str_cur_n))
+        return stri__utf8_count_codepoints(str_cur_s, str_cur_n);
+
     UChar32 c = 0;
     R_len_t j = 0;
     R_len_t cur_length = 0;
@@ -483,6 +496,30 @@ int stri__width_string(const char* str_cur_s, int str_cur_n, int max_width)
 }
 
 
+/** help struct for stri_width: computing the widths in parallel
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriWidthWorker {
+    const StriContainerUTF8* str_cont;
+    int* retint;
+
+    StriWidthWorker(const StriContainerUTF8* _str_cont, int* _retint)
+        : str_cont(_str_cont), retint(_retint)
+    { }
+
+    void operator() (R_len_t i, int /* thread_id */)
+    {
+        if (str_cont->isNA(i)) {
+            retint[i] = NA_INTEGER;
+            return;
+        }
+
+        retint[i] = stri__width_string(str_cont->get(i).c_str(), str_cont->get(i).length());
+    }
+};
+
+
 /**
   * Determine the width of strings
   *
@@ -490,6 +527,9 @@ int stri__width_string(const char* str_cur_s, int str_cur_n, int max_width)
   * @return integer vector
   *
   * @version 0.5-1 (Marek Gagolewski, 2015-04-22)
+  *
+  * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+  *    parallel execution (stri_options(threads=...))
   */
 SEXP stri_width(SEXP str)
 {
@@ -503,6 +543,14 @@ SEXP stri_width(SEXP str)
     STRI__PROTECT(ret = Rf_allocVector(INTSXP, str_n));
     int* retint = INTEGER(ret);
 
+    int nthreads = stri__parallel_get_num_threads(str_n);
+    if (nthreads > 1) {
+        StriWidthWorker worker(&str_cont, retint);
+        stri__parallel_for(str_n, nthreads, worker);
+        STRI__UNPROTECT_ALL
+        return ret;
+    }
+
     for (R_len_t i = str_cont.vectorize_init();
             i != str_cont.vectorize_end();
             i = str_cont.vectorize_next(i))
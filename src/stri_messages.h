@@ -91,6 +91,9 @@
 #define MSG__INCORRECT_REGEX_OPTION \
    "incorrect opts_regex setting: '%s'; ignoring"
 
+#define MSG__INCORRECT_STRI_OPTION \
+   "unknown stri_options setting: '%s'; ignoring"
+
 #define MSG__INVALID_CODE_POINT \
    "invalid Unicode code point \\U%08x"
 
@@ -342,6 +345,9 @@
 #define MSG__EMPTY_SEARCH_PATTERN_UNSUPPORTED \
    "empty search patterns are not supported"
 
+#define MSG__REGEX_SINGLE_PASS_UNSUPPORTED \
+   "the patterns cannot be combined into a single one (e.g., back-references are not supported); use single_pass=FALSE"
+
 #define MSG__OVERLAPPING_PATTERN_UNSUPPORTED \
    "overlapping pattern matches are not supported"
 
@@ -363,4 +369,10 @@
 #define MSG__CHARSXP_2147483647 \
     "Elements of character vectors (CHARSXPs) are limited to 2^31-1 bytes"
 
+#define MSG__FILE_WRITE_ERROR \
+   "cannot write to file `%s`"
+
+#define MSG__FILE_TRUNCATED \
+   "the file has been truncated while being read"
+
 #endif
@@ -0,0 +1,85 @@
+/* This file is part of the 'stringi' project.
+ * Copyright (c) 2013-2026, Marek Gagolewski <https://www.gagolewski.com/>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "stri_stringi.h"
+#include "stri_parallel.h"
+
+
+/** Maximal number of threads, see stri_options(threads=...) */
+static int stri__parallel_threads = 1;
+
+
+/** Get the maximal number of threads to be used
+ *
+ * @return value >= 1
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+int stri__parallel_get_threads()
+{
+    return stri__parallel_threads;
+}
+
+
+/** Set the maximal number of threads to be used
+ *
+ * @param nthreads value >= 1; ignored if OpenMP is not available
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+void stri__parallel_set_threads(int nthreads)
+{
+    STRI_ASSERT(nthreads >= 1)
+    stri__parallel_threads = nthreads;
+}
+
+
+/** Get the number of threads to process a given number of elements
+ *
+ * @param n number of elements
+ * @return value >= 1; 1 if OpenMP is not available or n is small
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+int stri__parallel_get_num_threads(R_len_t n)
+{
+#ifdef _OPENMP
+    int nthreads = stri__parallel_threads;
+    if (nthreads > omp_get_thread_limit()) nthreads = omp_get_thread_limit();
+    if (nthreads > n/STRI__PARALLEL_MIN_CHUNK) nthreads = n/STRI__PARALLEL_MIN_CHUNK;
+    return (nthreads > 1)?nthreads:1;
+#else
+    (void)n;  // unused
+    return 1;
+#endif
+}
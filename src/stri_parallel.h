@@ -0,0 +1,181 @@
+/* This file is part of the 'stringi' project.
+ * Copyright (c) 2013-2026, Marek Gagolewski <https://www.gagolewski.com/>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef __stri_parallel_h
+#define __stri_parallel_h
+
+
+#include "stri_stringi.h"
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+// a thread should process at least this many elements
+#define STRI__PARALLEL_MIN_CHUNK 1024
+
+
+int stri__parallel_get_threads();
+void stri__parallel_set_threads(int nthreads);
+int stri__parallel_get_num_threads(R_len_t n);
+
+
+/**
+ * Call f(i, thread_id) for all i in [0, n), possibly in parallel
+ * (OpenMP, stri_options(threads=...))
+ *
+ * f must not call R's API (no allocations, no SET_STRING_ELT,
+ * no warnings etc.); its results should be written to
+ * per-element storage and passed to R on the main thread afterwards.
+ * Per-thread resources (e.g., ICU objects that are not thread-safe)
+ * should be indexed by thread_id, which is in [0, nthreads).
+ *
+ * StriExceptions thrown by f are rethrown on the main thread.
+ *
+ * @param n number of elements
+ * @param nthreads number of threads, see stri__parallel_get_num_threads()
+ * @param f functor
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+template <class Function>
+void stri__parallel_for(R_len_t n, int nthreads, Function& f)
+{
+#ifdef _OPENMP
+    if (nthreads > 1) {
+        int failed = 0;
+        std::vector<StriException> error;  // the first exception caught (if any)
+
+        #pragma omp parallel for num_threads(nthreads) schedule(static)
+        for (R_len_t i=0; i<n; ++i) {
+            int cur_failed;
+            #pragma omp atomic read
+            cur_failed = failed;
+            if (cur_failed) continue;  // cannot break out of an OpenMP loop
+
+            try {
+                f(i, omp_get_thread_num());
+            }
+            catch (StriException& e) {
+                #pragma omp critical(stri__parallel_for_error)
+                {
+                    if (!failed) {
+                        error.push_back(e);
+                        #pragma omp atomic write
+                        failed = 1;
+                    }
+                }
+            }
+            catch (...) {
+                #pragma omp critical(stri__parallel_for_error)
+                {
+                    if (!failed) {
+                        error.push_back(StriException(MSG__INTERNAL_ERROR));
+                        #pragma omp atomic write
+                        failed = 1;
+                    }
+                }
+            }
+        }
+
+        if (failed)
+            throw error[0];  // as-is, so that no location prefix is added again
+        return;
+    }
+#else
+    (void)nthreads;  // unused
+#endif
+
+    for (R_len_t i=0; i<n; ++i)
+        f(i, 0);
+}
+
+
+/**
+ * Per-thread copies of a container, for use with stri__parallel_for()
+ *
+ * Pattern containers keep the recently used matchers, which
+ * must not be shared between threads. The copy for thread 0
+ * is the original container (not owned); the others are
+ * created with the container's copy constructor.
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+template <class Container>
+class StriParallelContainers {
+
+private:
+
+    std::vector<Container*> conts;
+
+    StriParallelContainers(const StriParallelContainers&); // not copyable
+    StriParallelContainers& operator=(const StriParallelContainers&);
+
+    void cleanup() {
+        for (size_t t=1; t<conts.size(); ++t) {
+            if (conts[t]) {
+                delete conts[t];
+                conts[t] = NULL;
+            }
+        }
+    }
+
+public:
+
+    StriParallelContainers(Container& cont, int nthreads)
+        : conts(nthreads, (Container*)NULL)
+    {
+        conts[0] = &cont;
+        try {
+            for (int t=1; t<nthreads; ++t)
+                conts[t] = new Container(cont);
+        }
+        catch (...) {
+            cleanup();
+            throw;
+        }
+    }
+
+    ~StriParallelContainers() {
+        cleanup();
+    }
+
+    inline Container& operator[](int thread_id) {
+        return *conts[thread_id];
+    }
+};
+
+
+#endif
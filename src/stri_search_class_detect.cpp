@@ -33,6 +33,51 @@
 #include "stri_stringi.h"
 #include "stri_container_utf8.h"
 #include "stri_container_charclass.h"
+#include "stri_parallel.h"
+
+
+/** help struct for stri_detect_charclass: pattern detection
+ *  in parallel (the containers are only read from)
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriDetectCharClassWorker {
+    const StriContainerUTF8* str_cont;
+    StriContainerCharClass* pattern_cont;
+    bool negate;
+    int* ret_tab;
+
+    StriDetectCharClassWorker(const StriContainerUTF8* _str_cont,
+        StriContainerCharClass* _pattern_cont, bool _negate, int* _ret_tab)
+        : str_cont(_str_cont), pattern_cont(_pattern_cont),
+          negate(_negate), ret_tab(_ret_tab)
+    { }
+
+    void operator() (R_len_t i, int /* thread_id */)
+    {
+        if (str_cont->isNA(i) || pattern_cont->isNA(i)) {
+            ret_tab[i] = NA_LOGICAL;
+            return;
+        }
+
+        const UnicodeSet* pattern_cur = &pattern_cont->get(i);
+        R_len_t     str_cur_n = str_cont->get(i).length();
+        const char* str_cur_s = str_cont->get(i).c_str();
+
+        UChar32 chr = 0;
+        ret_tab[i] = FALSE;
+        for (R_len_t j=0; j<str_cur_n; ) {
+            U8_NEXT(str_cur_s, j, str_cur_n, chr);
+            if (chr < 0) // invalid UTF-8 sequence
+                throw StriException(MSG__INVALID_UTF8);
+            if (pattern_cur->contains(chr)) {
+                ret_tab[i] = TRUE;
+                break;
+            }
+        }
+        if (negate) ret_tab[i] = !ret_tab[i];
+    }
+};
 
 
 /**
@@ -69,6 +114,9 @@
  *
  * @version 1.3.1 (Marek Gagolewski, 2019-02-08)
  *    #232: `max_count` arg added
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    parallel execution (stri_options(threads=...)) if max_count < 0
  */
 SEXP stri_detect_charclass(SEXP str, SEXP pattern,
                            SEXP negate, SEXP max_count)
@@ -88,6 +136,14 @@ SEXP stri_detect_charclass(SEXP str, SEXP pattern,
     STRI__PROTECT(ret = Rf_allocVector(LGLSXP, vectorize_length));
     int* ret_tab = LOGICAL(ret);
 
+    int nthreads = (max_count_1 < 0)?stri__parallel_get_num_threads(vectorize_length):1;
+    if (nthreads > 1) {
+        StriDetectCharClassWorker worker(&str_cont, &pattern_cont, negate_1, ret_tab);
+        stri__parallel_for(vectorize_length, nthreads, worker);
+        STRI__UNPROTECT_ALL
+        return ret;
+    }
+
     for (R_len_t i = pattern_cont.vectorize_init();
             i != pattern_cont.vectorize_end();
             i = pattern_cont.vectorize_next(i))
@@ -33,9 +33,54 @@
 #include "stri_stringi.h"
 #include "stri_container_utf16.h"
 #include "stri_container_usearch.h"
+#include "stri_parallel.h"
 #include <unicode/uregex.h>
 
 
+/** help struct for stri_detect_coll: pattern detection
+ *  in parallel, each thread uses its own pattern container (and matchers);
+ *  the collator is shared (its const API is thread-safe)
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriDetectCollWorker {
+    const StriContainerUTF16* str_cont;
+    StriParallelContainers<StriContainerUStringSearch>* pattern_conts;
+    bool negate;
+    int* ret_tab;
+
+    StriDetectCollWorker(const StriContainerUTF16* _str_cont,
+        StriParallelContainers<StriContainerUStringSearch>* _pattern_conts,
+        bool _negate, int* _ret_tab)
+        : str_cont(_str_cont), pattern_conts(_pattern_conts),
+          negate(_negate), ret_tab(_ret_tab)
+    { }
+
+    void operator() (R_len_t k, int thread_id)
+    {
+        StriContainerUStringSearch& pattern_cont = (*pattern_conts)[thread_id];
+        R_len_t i = pattern_cont.vectorize_get(k);
+        if (str_cont->isNA(i) || pattern_cont.isNA(i) || pattern_cont.get(i).length() <= 0) {
+            ret_tab[i] = NA_LOGICAL;
+            return;
+        }
+        else if (str_cont->get(i).length() <= 0) {
+            ret_tab[i] = negate;
+            return;
+        }
+
+        UStringSearch *matcher = pattern_cont.getMatcher(i, str_cont->get(i));
+        usearch_reset(matcher);
+
+        UErrorCode status = U_ZERO_ERROR;
+        ret_tab[i] = ((int)usearch_first(matcher, &status) != USEARCH_DONE);
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+        if (negate) ret_tab[i] = !ret_tab[i];
+    }
+};
+
+
 /**
  * Detect if a pattern occurs in a string [with collation]
  *
@@ -66,6 +111,9 @@
  *
  * @version 1.3.1 (Marek Gagolewski, 2019-02-08)
  *    #232: `max_count` arg added
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    parallel execution (stri_options(threads=...)) if max_count < 0
  */
 SEXP stri_detect_coll(SEXP str, SEXP pattern, SEXP negate,
                       SEXP max_count, SEXP opts_collator)
@@ -89,6 +137,20 @@ SEXP stri_detect_coll(SEXP str, SEXP pattern, SEXP negate,
     STRI__PROTECT(ret = Rf_allocVector(LGLSXP, vectorize_length));
     int* ret_tab = LOGICAL(ret);
 
+    int nthreads = (max_count_1 < 0)?stri__parallel_get_num_threads(vectorize_length):1;
+    if (nthreads > 1) {
+        StriParallelContainers<StriContainerUStringSearch> pattern_conts(pattern_cont, nthreads);
+        StriDetectCollWorker worker(&str_cont, &pattern_conts, negate_1, ret_tab);
+        stri__parallel_for(vectorize_length, nthreads, worker);
+
+        if (collator) {
+            ucol_close(collator);
+            collator=NULL;
+        }
+        STRI__UNPROTECT_ALL
+        return ret;
+    }
+
     for (R_len_t i = pattern_cont.vectorize_init();
             i != pattern_cont.vectorize_end();
             i = pattern_cont.vectorize_next(i))
@@ -33,6 +33,46 @@
 #include "stri_stringi.h"
 #include "stri_container_utf8.h"
 #include "stri_container_bytesearch.h"
+#include "stri_parallel.h"
+
+
+/** help struct for stri_detect_fixed: pattern detection
+ *  in parallel, each thread uses its own pattern container (and matchers)
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriDetectFixedWorker {
+    const StriContainerUTF8* str_cont;
+    StriParallelContainers<StriContainerByteSearch>* pattern_conts;
+    bool negate;
+    int* ret_tab;
+
+    StriDetectFixedWorker(const StriContainerUTF8* _str_cont,
+        StriParallelContainers<StriContainerByteSearch>* _pattern_conts,
+        bool _negate, int* _ret_tab)
+        : str_cont(_str_cont), pattern_conts(_pattern_conts),
+          negate(_negate), ret_tab(_ret_tab)
+    { }
+
+    void operator() (R_len_t k, int thread_id)
+    {
+        StriContainerByteSearch& pattern_cont = (*pattern_conts)[thread_id];
+        R_len_t i = pattern_cont.vectorize_get(k);
+        if (str_cont->isNA(i) || pattern_cont.isNA(i) || pattern_cont.get(i).length() <= 0) {
+            ret_tab[i] = NA_LOGICAL;
+            return;
+        }
+        else if (str_cont->get(i).length() <= 0) {
+            ret_tab[i] = negate;
+            return;
+        }
+
+        StriByteSearchMatcher* matcher = pattern_cont.getMatcher(i);
+        matcher->reset(str_cont->get(i).c_str(), str_cont->get(i).length());
+        ret_tab[i] = (int)(matcher->findFirst() != USEARCH_DONE);
+        if (negate) ret_tab[i] = !ret_tab[i];
+    }
+};
 
 
 /**
@@ -72,6 +112,9 @@
  *
  * @version 1.3.1 (Marek Gagolewski, 2019-02-08)
  *    #232: `max_count` arg added
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    parallel execution (stri_options(threads=...)) if max_count < 0
  */
 SEXP stri_detect_fixed(SEXP str, SEXP pattern, SEXP negate,
                        SEXP max_count, SEXP opts_fixed)
@@ -91,6 +134,15 @@ SEXP stri_detect_fixed(SEXP str, SEXP pattern, SEXP negate,
     STRI__PROTECT(ret = Rf_allocVector(LGLSXP, vectorize_length));
     int* ret_tab = LOGICAL(ret);
 
+    int nthreads = (max_count_1 < 0)?stri__parallel_get_num_threads(vectorize_length):1;
+    if (nthreads > 1) {
+        StriParallelContainers<StriContainerByteSearch> pattern_conts(pattern_cont, nthreads);
+        StriDetectFixedWorker worker(&str_cont, &pattern_conts, negate_1, ret_tab);
+        stri__parallel_for(vectorize_length, nthreads, worker);
+        STRI__UNPROTECT_ALL
+        return ret;
+    }
+
     for (R_len_t i = pattern_cont.vectorize_init();
             i != pattern_cont.vectorize_end();
             i = pattern_cont.vectorize_next(i))
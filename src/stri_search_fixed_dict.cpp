@@ -0,0 +1,368 @@
+/* This file is part of the 'stringi' project.
+ * Copyright (c) 2013-2026, Marek Gagolewski <https://www.gagolewski.com/>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "stri_stringi.h"
+#include "stri_container_utf8.h"
+#include "stri_container_bytesearch.h"
+#include "stri_bytesearch_dict.h"
+#include "stri_string8buf.h"
+#include <vector>
+#include <algorithm>
+
+
+/**
+ * Generate a warning if there are empty patterns in the dictionary
+ *
+ * @param dict_cont dictionary
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static void stri__dict_warn_on_empty(StriContainerUTF8& dict_cont)
+{
+    R_len_t dict_n = dict_cont.get_n();
+    for (R_len_t j=0; j<dict_n; ++j) {
+        if (!dict_cont.isNA(j) && dict_cont.get(j).length() <= 0) {
+            Rf_warning(MSG__EMPTY_SEARCH_PATTERN_UNSUPPORTED);
+            return;
+        }
+    }
+}
+
+
+/**
+ * Check if the i-th string can be searched in; if not, generate
+ * a warning (only once per call)
+ *
+ * @param matcher dictionary matcher
+ * @param str_cont strings
+ * @param i index of a non-NA string
+ * @param warned has the warning been generated already?
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static bool stri__dict_is_searchable(const StriByteSearchDict& matcher,
+    StriContainerUTF8& str_cont, R_len_t i, bool& warned)
+{
+    if (matcher.isSearchable(str_cont.get(i).c_str(), str_cont.get(i).length()))
+        return true;
+
+    if (!warned) {
+        Rf_warning(MSG__INVALID_CODE_POINT_REPLNA);
+        warned = true;
+    }
+    return false;
+}
+
+
+/**
+ * Detect which of the patterns in a dictionary occur in each string
+ * [single pass, Aho-Corasick]
+ *
+ * @param str character vector
+ * @param dict character vector
+ * @param simplify single logical
+ * @param opts_fixed list
+ * @return logical matrix with length(str) rows and length(dict) columns
+ *    or a list of integer vectors with the indexes of the matching patterns
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+SEXP stri_detect_dict(SEXP str, SEXP dict, SEXP simplify, SEXP opts_fixed)
+{
+    bool simplify_1 = stri__prepare_arg_logical_1_notNA(simplify, "simplify");
+    uint32_t pattern_flags = StriContainerByteSearch::getByteSearchFlags(opts_fixed);
+    PROTECT(str = stri__prepare_arg_string(str, "str"));
+    PROTECT(dict = stri__prepare_arg_string(dict, "dict"));
+
+    STRI__ERROR_HANDLER_BEGIN(2)
+    R_len_t str_n = LENGTH(str);
+    R_len_t dict_n = LENGTH(dict);
+    StriContainerUTF8 str_cont(str, str_n);
+    StriContainerUTF8 dict_cont(dict, dict_n);
+    stri__dict_warn_on_empty(dict_cont);
+
+    StriByteSearchDict matcher(dict_cont,
+        (bool)(pattern_flags&StriContainerByteSearch::BYTESEARCH_CASE_INSENSITIVE));
+
+    bool warned = false;  // ill-formed UTF-8 in the case-insensitive mode
+    SEXP ret;
+    if (simplify_1) {
+        STRI__PROTECT(ret = Rf_allocMatrix(LGLSXP, str_n, dict_n));
+        int* ret_tab = LOGICAL(ret);
+
+        for (R_len_t i=0; i<str_n; ++i) {
+            if (str_cont.isNA(i) || !stri__dict_is_searchable(matcher, str_cont, i, warned)) {
+                for (R_len_t j=0; j<dict_n; ++j)
+                    ret_tab[i+(R_xlen_t)j*str_n] = NA_LOGICAL;
+                continue;
+            }
+
+            for (R_len_t j=0; j<dict_n; ++j)
+                ret_tab[i+(R_xlen_t)j*str_n] = (matcher.getPatternLength(j) > 0)?FALSE:NA_LOGICAL;
+
+            matcher.reset(str_cont.get(i).c_str(), str_cont.get(i).length());
+            R_len_t j;
+            while ((j = matcher.findNext()) >= 0)
+                ret_tab[i+(R_xlen_t)j*str_n] = TRUE;
+        }
+    }
+    else {
+        STRI__PROTECT(ret = Rf_allocVector(VECSXP, str_n));
+        std::vector<R_len_t> last_seen(dict_n, -1);
+        std::vector<R_len_t> found;
+
+        for (R_len_t i=0; i<str_n; ++i) {
+            if (str_cont.isNA(i) || !stri__dict_is_searchable(matcher, str_cont, i, warned)) {
+                SET_VECTOR_ELT(ret, i, Rf_ScalarInteger(NA_INTEGER));
+                continue;
+            }
+
+            found.clear();
+            matcher.reset(str_cont.get(i).c_str(), str_cont.get(i).length());
+            R_len_t j;
+            while ((j = matcher.findNext()) >= 0) {
+                if (last_seen[j] == i) continue;
+                last_seen[j] = i;
+                found.push_back(j);
+            }
+            std::sort(found.begin(), found.end());
+
+            SEXP cur_res;
+            STRI__PROTECT(cur_res = Rf_allocVector(INTSXP, (R_len_t)found.size()));
+            int* cur_res_tab = INTEGER(cur_res);
+            for (size_t k=0; k<found.size(); ++k)
+                cur_res_tab[k] = found[k]+1;
+            SET_VECTOR_ELT(ret, i, cur_res);
+            STRI__UNPROTECT(1);
+        }
+    }
+
+    STRI__UNPROTECT_ALL
+    return ret;
+    STRI__ERROR_HANDLER_END( ;/* do nothing special on error */ )
+}
+
+
+/**
+ * Count the number of occurrences of each pattern in a dictionary
+ * in each string [single pass, Aho-Corasick]
+ *
+ * @param str character vector
+ * @param dict character vector
+ * @param opts_fixed list
+ * @return integer matrix with length(str) rows and length(dict) columns
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+SEXP stri_count_dict(SEXP str, SEXP dict, SEXP opts_fixed)
+{
+    uint32_t pattern_flags = StriContainerByteSearch::getByteSearchFlags(opts_fixed, /*allow_overlap*/true);
+    PROTECT(str = stri__prepare_arg_string(str, "str"));
+    PROTECT(dict = stri__prepare_arg_string(dict, "dict"));
+
+    STRI__ERROR_HANDLER_BEGIN(2)
+    R_len_t str_n = LENGTH(str);
+    R_len_t dict_n = LENGTH(dict);
+    StriContainerUTF8 str_cont(str, str_n);
+    StriContainerUTF8 dict_cont(dict, dict_n);
+    stri__dict_warn_on_empty(dict_cont);
+
+    bool overlap = (bool)(pattern_flags&StriContainerByteSearch::BYTESEARCH_OVERLAP);
+    StriByteSearchDict matcher(dict_cont,
+        (bool)(pattern_flags&StriContainerByteSearch::BYTESEARCH_CASE_INSENSITIVE));
+
+    SEXP ret;
+    STRI__PROTECT(ret = Rf_allocMatrix(INTSXP, str_n, dict_n));
+    int* ret_tab = INTEGER(ret);
+    std::vector<R_len_t> last_end(dict_n); // non-overlapping mode: where the last counted match ends
+    bool warned = false;  // ill-formed UTF-8 in the case-insensitive mode
+
+    for (R_len_t i=0; i<str_n; ++i) {
+        if (str_cont.isNA(i) || !stri__dict_is_searchable(matcher, str_cont, i, warned)) {
+            for (R_len_t j=0; j<dict_n; ++j)
+                ret_tab[i+(R_xlen_t)j*str_n] = NA_INTEGER;
+            continue;
+        }
+
+        for (R_len_t j=0; j<dict_n; ++j)
+            ret_tab[i+(R_xlen_t)j*str_n] = (matcher.getPatternLength(j) > 0)?0:NA_INTEGER;
+
+        if (!overlap)
+            std::fill(last_end.begin(), last_end.end(), 0);
+
+        matcher.reset(str_cont.get(i).c_str(), str_cont.get(i).length());
+        R_len_t j;
+        while ((j = matcher.findNext()) >= 0) {
+            if (!overlap) {
+                // matches of the same pattern are reported in the order
+                // of their end (and hence start) positions
+                if (matcher.getMatchedStart() < last_end[j]) continue;
+                last_end[j] = matcher.getMatchedEnd();
+            }
+            ++ret_tab[i+(R_xlen_t)j*str_n];
+        }
+    }
+
+    STRI__UNPROTECT_ALL
+    return ret;
+    STRI__ERROR_HANDLER_END( ;/* do nothing special on error */ )
+}
+
+
+/**
+ * Replace all occurrences of the patterns in a dictionary
+ * [single pass, Aho-Corasick, leftmost-longest]
+ *
+ * The input is scanned once; at each position, the longest of the
+ * patterns starting there is replaced (ties are resolved in favour of
+ * the pattern that comes first in the dictionary) and the search resumes
+ * right after it. Hence, unlike in stri__replace_all_fixed_no_vectorize_all,
+ * the replacement strings are never searched in.
+ *
+ * @param str character vector
+ * @param dict character vector
+ * @param replacement character vector, recycled to the length of dict
+ * @param opts_fixed list
+ * @return character vector
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+SEXP stri_replace_all_dict(SEXP str, SEXP dict, SEXP replacement, SEXP opts_fixed)
+{
+    uint32_t pattern_flags = StriContainerByteSearch::getByteSearchFlags(opts_fixed);
+    PROTECT(str         = stri__prepare_arg_string(str, "str"));
+    PROTECT(dict        = stri__prepare_arg_string(dict, "dict"));
+    PROTECT(replacement = stri__prepare_arg_string(replacement, "replacement"));
+
+    R_len_t str_n = LENGTH(str);
+    R_len_t dict_n = LENGTH(dict);
+    R_len_t replacement_n = LENGTH(replacement);
+    if (dict_n < replacement_n || dict_n <= 0 || replacement_n <= 0) {
+        UNPROTECT(3);
+        Rf_error(MSG__WARN_RECYCLING_RULE2); // error() call allowed here
+    }
+    if (dict_n % replacement_n != 0)
+        Rf_warning(MSG__WARN_RECYCLING_RULE);
+
+    STRI__ERROR_HANDLER_BEGIN(3)
+    StriContainerUTF8 str_cont(str, str_n);
+    StriContainerUTF8 dict_cont(dict, dict_n);
+    StriContainerUTF8 replacement_cont(replacement, dict_n);
+
+    // the same as in stri_replace_all_fixed(vectorize_all=FALSE)
+    for (R_len_t j=0; j<dict_n; ++j) {
+        if (dict_cont.isNA(j)) {
+            STRI__UNPROTECT_ALL
+            return stri__vector_NA_strings(str_n);
+        }
+        else if (dict_cont.get(j).length() <= 0) {
+            Rf_warning(MSG__EMPTY_SEARCH_PATTERN_UNSUPPORTED);
+            STRI__UNPROTECT_ALL
+            return stri__vector_NA_strings(str_n);
+        }
+    }
+
+    StriByteSearchDict matcher(dict_cont,
+        (bool)(pattern_flags&StriContainerByteSearch::BYTESEARCH_CASE_INSENSITIVE));
+
+    SEXP ret;
+    STRI__PROTECT(ret = Rf_allocVector(STRSXP, str_n));
+
+    std::vector< std::pair<R_len_t, R_len_t> > occurrences; // (start, end)
+    std::vector<R_len_t> matched; // the corresponding patterns
+    String8buf buf(0);
+    bool warned = false;  // ill-formed UTF-8 in the case-insensitive mode
+
+    for (R_len_t i=0; i<str_n; ++i) {
+        if (str_cont.isNA(i) || !stri__dict_is_searchable(matcher, str_cont, i, warned)) {
+            SET_STRING_ELT(ret, i, NA_STRING);
+            continue;
+        }
+
+        const char* str_cur_s = str_cont.get(i).c_str();
+        R_len_t str_cur_n = str_cont.get(i).length();
+
+        occurrences.clear();
+        matched.clear();
+        bool na_result = false;
+        R_len_t buf_need = str_cur_n;
+        matcher.reset(str_cur_s, str_cur_n);
+        R_len_t j;
+        while ((j = matcher.findNextLongest()) >= 0) {
+            if (replacement_cont.isNA(j)) {
+                na_result = true;
+                break;
+            }
+            R_len_t start = matcher.getMatchedStart();
+            R_len_t end = matcher.getMatchedEnd();
+            buf_need += replacement_cont.get(j).length()-(end-start);
+            occurrences.push_back(std::pair<R_len_t, R_len_t>(start, end));
+            matched.push_back(j);
+        }
+
+        if (na_result) {
+            SET_STRING_ELT(ret, i, NA_STRING);
+            continue;
+        }
+        else if (occurrences.empty()) {
+            SET_STRING_ELT(ret, i, str_cont.toR(i));
+            continue;
+        }
+
+        buf.resize(buf_need, false/*destroy contents*/);
+        char* buf_cur = buf.data();
+        R_len_t last_end = 0;
+        for (size_t k=0; k<occurrences.size(); ++k) {
+            R_len_t start = occurrences[k].first;
+            j = matched[k];
+            memcpy(buf_cur, str_cur_s+last_end, (size_t)(start-last_end));
+            buf_cur += start-last_end;
+            memcpy(buf_cur, replacement_cont.get(j).c_str(), (size_t)replacement_cont.get(j).length());
+            buf_cur += replacement_cont.get(j).length();
+            last_end = occurrences[k].second;
+        }
+        memcpy(buf_cur, str_cur_s+last_end, (size_t)(str_cur_n-last_end));
+        buf_cur += str_cur_n-last_end;
+
+#ifndef NDEBUG
+        if (buf_need != (R_len_t)(buf_cur-buf.data()))
+            throw StriException("!NDEBUG: stri_replace_all_dict: (buf_need != buf_used)");
+#endif
+
+        SET_STRING_ELT(ret, i, Rf_mkCharLenCE(buf.data(), buf_need, CE_UTF8));
+    }
+
+    STRI__UNPROTECT_ALL
+    return ret;
+    STRI__ERROR_HANDLER_END( ;/* do nothing special on error */ )
+}
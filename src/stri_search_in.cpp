@@ -30,211 +30,262 @@
  */
 
 
-//// VERSION III: naive O(n*m) - damn slower
-//#include "stri_stringi.h"
-//#include "stri_container_utf8.h"
-//
-//
-///** Value Matching
-// *
-// * @param str character vector
-// * @param table character vector
-// * @nomatch single integer value
-// *
-// * @return integer vector
-// *
-// * @version 0.3-1 (Marek Gagolewski, 2014-06-06)
-// */
-//SEXP stri_in_fixed(SEXP str, SEXP table, SEXP nomatch)
-//{
-//   str = stri__prepare_arg_string(str, "str");
-//   table = stri__prepare_arg_string(table, "table");
-//   nomatch = stri__prepare_arg_integer_1(nomatch, "nomatch");
-//   R_len_t str_length = LENGTH(str);
-//   R_len_t table_length = LENGTH(table);
-//
-//   R_len_t nomatch_cur = INTEGER(nomatch)[0];
-//
-//   STRI__ERROR_HANDLER_BEGIN
-//   StriContainerUTF8 str_cont(str, str_length);
-//   StriContainerUTF8 table_cont(table, table_length);
-//
-//   SEXP ret;
-//   STRI__PROTECT(ret = Rf_allocVector(INTSXP, str_length));
-//   int* ret_tab = INTEGER(ret);
-//
-//   for (R_len_t i = 0; i<str_length; ++i) {
-//      if (str_cont.isNA(i)) {
-//         ret_tab[i] = NA_INTEGER;
-//         continue;
-//      }
-//
-//      const char* str_cur = str_cont.get(i).c_str();
-//
-//      ret_tab[i] = nomatch_cur;
-//      for (int j=0; j<table_length; ++j) {
-//         if (table_cont.isNA(j)) continue;
-//         if (!strcmp(str_cur, table_cont.get(j).c_str())) {
-//            ret_tab[i] = j+1;
-//            break;
-//         }
-//      }
-//
-//      // ... and so on
-//      // it's already slower than match() for n <= 100000
-//
-////      if (it != dict.end())
-////         ret_tab[i] = (*it).second;
-////      else
-////         ret_tab[i] = nomatch_cur;
-//   }
-//
-//   STRI__UNPROTECT_ALL
-//   return ret;
-//   STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
-//}
-
-
-//// VERSION II: sort() table, then (*unfinished*) bin search
-//#include "stri_stringi.h"
-//#include "stri_container_utf8.h"
-//#include <algorithm>
-//#include <vector>
-//
-///** helper struct (comparer) for stri_in_fixed
-// *
-// */
-//struct cmp_str
-//{
-//   StriContainerUTF8* cont;
-//
-//   cmp_str(StriContainerUTF8* _cont) {
-//      cont = _cont;
-//   }
-//
-//   bool operator()(int i, int j)
-//   {
-//      if (cont->isNA(i)) return false;
-//      else if (cont->isNA(j)) return true;
-//      else return strcmp(cont->get(i).c_str(), cont->get(j).c_str()) < 0;
-//   }
-//};
-//
-//
-///** Value Matching
-// *
-// * @param str character vector
-// * @param table character vector
-// * @nomatch single integer value
-// *
-// * @return integer vector
-// *
-// * @version 0.3-1 (Marek Gagolewski, 2014-06-06)
-// */
-//SEXP stri_in_fixed(SEXP str, SEXP table, SEXP nomatch)
-//{
-//   str = stri__prepare_arg_string(str, "str");
-//   table = stri__prepare_arg_string(table, "table");
-//   nomatch = stri__prepare_arg_integer_1(nomatch, "nomatch");
-//   R_len_t str_length = LENGTH(str);
-//   R_len_t table_length = LENGTH(table);
-//
-//   R_len_t nomatch_cur = INTEGER(nomatch)[0];
-//
-//   STRI__ERROR_HANDLER_BEGIN
-//   StriContainerUTF8 str_cont(str, str_length);
-//   StriContainerUTF8 table_cont(table, table_length);
-//
-//   cmp_str comparer(&str_cont);
-//   std::vector<int> idx(table_length);
-//   for (int i=0; i<table_length; ++i) {
-//      idx[i] = i;
-//   }
-//
-//   std::sort(idx.begin(), idx.end(), comparer);
-//
-//   SEXP ret;
-//   STRI__PROTECT(ret = Rf_allocVector(INTSXP, str_length));
-//   int* ret_tab = INTEGER(ret);
-//
-//   for (R_len_t i = 0; i<str_length; ++i) {
-//      if (str_cont.isNA(i)) {
-//         ret_tab[i] = NA_INTEGER;
-//         continue;
-//      }
-//
-//      // ... and so on
-//      // it's already slower than match() for n <= 100000
-//
-////      if (it != dict.end())
-////         ret_tab[i] = (*it).second;
-////      else
-////         ret_tab[i] = nomatch_cur;
-//   }
-//
-//   STRI__UNPROTECT_ALL
-//   return ret;
-//   STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
-//}
-
-
-// // VERSION I: using boost's unordered_map
-//
-//#include "stri_stringi.h"
-//#include "stri_container_utf8.h"
-//#include <boost/unordered/unordered_map.hpp>
-//#include <string>
-//
-//
-///** Value Matching
-// *
-// * @param str character vector
-// * @param table character vector
-// * @nomatch single integer value
-// *
-// * @return integer vector
-// *
-// * @version 0.3-1 (Marek Gagolewski, 2014-06-06)
-// */
-//SEXP stri_in_fixed(SEXP str, SEXP table, SEXP nomatch)
-//{
-//   str = stri__prepare_arg_string(str, "str");
-//   table = stri__prepare_arg_string(table, "table");
-//   nomatch = stri__prepare_arg_integer_1(nomatch, "nomatch");
-//   R_len_t str_length = LENGTH(str);
-//   R_len_t table_length = LENGTH(table);
-//
-//   R_len_t nomatch_cur = INTEGER(nomatch)[0];
-//
-//   STRI__ERROR_HANDLER_BEGIN
-//   StriContainerUTF8 str_cont(str, str_length);
-//   StriContainerUTF8 table_cont(table, table_length);
-//
-//   boost::unordered_map<std::string, R_len_t> dict(table_length);
-//   for (R_len_t i=table_length-1; i>=0; --i) {
-//      if (table_cont.isNA(i)) continue;
-//      dict[std::string(table_cont.get(i).c_str())] = i+1; // 0-based index -> 1-based
-//   }
-//
-//   SEXP ret;
-//   STRI__PROTECT(ret = Rf_allocVector(INTSXP, str_length));
-//   int* ret_tab = INTEGER(ret);
-//
-//   for (R_len_t i = 0; i<str_length; ++i) {
-//      if (str_cont.isNA(i)) {
-//         ret_tab[i] = NA_INTEGER;
-//         continue;
-//      }
-//
-//      std::string str_cur(str_cont.get(i).c_str());
-//      boost::unordered_map<std::string, R_len_t>::iterator it = dict.find(str_cur);
-//      if (it != dict.end())
-//         ret_tab[i] = (*it).second;
-//      else
-//         ret_tab[i] = nomatch_cur;
-//   }
-//
-//   STRI__UNPROTECT_ALL
-//   return ret;
-//   STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
-//}
+#include "stri_stringi.h"
+#include "stri_container_utf8.h"
+#include "stri_container_bytesearch.h"
+#include <unicode/normalizer2.h>
+#include <unicode/ucasemap.h>
+#include <unicode/bytestream.h>
+#include <vector>
+#include <string>
+
+
+/**
+ * Prepares the keys compared by stri_in_fixed:
+ * optionally NFC-normalised and/or case-folded UTF-8 strings
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriInFixedKeyMaker {
+
+private:
+
+    const Normalizer2* nfc;  ///< NULL if no normalisation is requested; not owned
+    UCaseMap* ucasemap;      ///< NULL if no case folding is requested
+    std::string buf1;        ///< result buffers
+    std::string buf2;
+
+    StriInFixedKeyMaker(const StriInFixedKeyMaker&); /* not copy-able */
+    StriInFixedKeyMaker& operator=(const StriInFixedKeyMaker&);
+
+    /** NFC-normalise s; the result is stored in buf (if needed) */
+    void normalize(const char*& s, R_len_t& n, std::string& buf) {
+        UErrorCode status = U_ZERO_ERROR;
+        if (nfc->isNormalizedUTF8(StringPiece(s, n), status)) {
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            return;
+        }
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+        buf.clear();
+        StringByteSink<std::string> sink(&buf);
+        nfc->normalizeUTF8(0, StringPiece(s, n), sink, NULL, status);
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        s = buf.data();
+        n = (R_len_t)buf.size();
+    }
+
+    /** apply full case folding on s; the result is stored in buf */
+    void casefold(const char*& s, R_len_t& n, std::string& buf) {
+        if (buf.size() < (size_t)n+16) buf.resize(n+16);
+        UErrorCode status = U_ZERO_ERROR;
+        int32_t buf_need = ucasemap_utf8FoldCase(ucasemap,
+            &buf[0], (int32_t)buf.size(), s, n, &status);
+        if (status == U_BUFFER_OVERFLOW_ERROR) {
+            buf.resize(buf_need);
+            status = U_ZERO_ERROR;
+            buf_need = ucasemap_utf8FoldCase(ucasemap,
+                &buf[0], (int32_t)buf.size(), s, n, &status);
+        }
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        s = buf.data();
+        n = (R_len_t)buf_need;
+    }
+
+public:
+
+    StriInFixedKeyMaker(bool normalize, bool case_insensitive)
+        : nfc(NULL), ucasemap(NULL)
+    {
+        UErrorCode status = U_ZERO_ERROR;
+        if (normalize) {
+            nfc = Normalizer2::getNFCInstance(status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        }
+        if (case_insensitive) {
+            ucasemap = ucasemap_open(NULL, U_FOLD_CASE_DEFAULT, &status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        }
+    }
+
+    ~StriInFixedKeyMaker() {
+        if (ucasemap) {
+            ucasemap_close(ucasemap);
+            ucasemap = NULL;
+        }
+    }
+
+    /** whether the keys differ from the input strings */
+    bool isIdentity() const {
+        return !nfc && !ucasemap;
+    }
+
+    /** transform s in-place; the result is valid until the next call */
+    void make(const char*& s, R_len_t& n) {
+        if (nfc) normalize(s, n, buf1);
+        if (ucasemap) {
+            casefold(s, n, (s == buf1.data())?buf2:buf1);
+            // case folding may denormalise a string
+            if (nfc) normalize(s, n, (s == buf1.data())?buf2:buf1);
+        }
+    }
+};
+
+
+/**
+ * An open-addressing (linear probing) hash table
+ * storing the indexes of the distinct strings in a vector
+ *
+ * The strings themselves are not copied: they must outlive the table.
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriInFixedHashTable {
+
+private:
+
+    std::vector<R_len_t> slots;        ///< item index or -1 if empty
+    std::vector<uint32_t> hashes;      ///< hash of each item
+    std::vector<const char*> keys;     ///< item data
+    std::vector<R_len_t> lens;         ///< item lengths in bytes
+    size_t mask;                       ///< slots.size()-1
+
+    StriInFixedHashTable(const StriInFixedHashTable&); /* not copy-able */
+    StriInFixedHashTable& operator=(const StriInFixedHashTable&);
+
+    /** 32-bit FNV-1a */
+    static uint32_t hash(const char* s, R_len_t n) {
+        uint32_t h = 2166136261u;
+        for (R_len_t i=0; i<n; ++i) {
+            h ^= (uint8_t)s[i];
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    /** position of the slot with a given key or of the empty slot
+     *  where it should be inserted */
+    size_t probe(const char* s, R_len_t n, uint32_t h) const {
+        size_t pos = (size_t)h & mask;
+        while (slots[pos] >= 0) {
+            R_len_t j = slots[pos];
+            if (hashes[j] == h && lens[j] == n && memcmp(keys[j], s, n) == 0)
+                break;
+            pos = (pos+1) & mask;
+        }
+        return pos;
+    }
+
+public:
+
+    /** @param n maximal number of items to be stored */
+    StriInFixedHashTable(R_len_t n)
+        : hashes(n), keys(n, (const char*)NULL), lens(n, 0)
+    {
+        size_t capacity = 16;
+        while (capacity < (size_t)n + (size_t)n/3 + 1) // max load factor 0.75
+            capacity *= 2;
+        slots.resize(capacity, -1);
+        mask = capacity-1;
+    }
+
+    /** add the idx-th item unless an equal one is already there */
+    void insert(R_len_t idx, const char* s, R_len_t n) {
+        uint32_t h = hash(s, n);
+        keys[idx] = s;
+        lens[idx] = n;
+        hashes[idx] = h;
+        size_t pos = probe(s, n, h);
+        if (slots[pos] < 0) slots[pos] = idx;
+    }
+
+    /** index of the first item equal to s or -1 if there is none */
+    R_len_t find(const char* s, R_len_t n) const {
+        size_t pos = probe(s, n, hash(s, n));
+        return slots[pos];
+    }
+};
+
+
+/** Value matching of UTF-8 strings [hashing]
+ *
+ * @param str character vector
+ * @param table character vector
+ * @param nomatch single integer value
+ * @param normalize single logical value
+ * @param opts_fixed list
+ *
+ * @return integer vector
+ *
+ * @version 0.3-1 (Marek Gagolewski, 2014-06-06)
+ *    the first experimental versions (naive, sorting, boost::unordered_map),
+ *    all slower than base::match
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    open-addressing hash table; optional normalisation and case folding
+ */
+SEXP stri_in_fixed(SEXP str, SEXP table, SEXP nomatch, SEXP normalize, SEXP opts_fixed)
+{
+    uint32_t pattern_flags = StriContainerByteSearch::getByteSearchFlags(opts_fixed);
+    bool normalize_val = stri__prepare_arg_logical_1_notNA(normalize, "normalize");
+    PROTECT(str = stri__prepare_arg_string(str, "str"));
+    PROTECT(table = stri__prepare_arg_string(table, "table"));
+    PROTECT(nomatch = stri__prepare_arg_integer_1(nomatch, "nomatch"));
+    R_len_t str_length = LENGTH(str);
+    R_len_t table_length = LENGTH(table);
+    int nomatch_cur = INTEGER(nomatch)[0];
+
+    STRI__ERROR_HANDLER_BEGIN(3)
+    StriContainerUTF8 str_cont(str, str_length);
+    StriContainerUTF8 table_cont(table, table_length);
+    StriInFixedKeyMaker keymaker(normalize_val,
+        (bool)(pattern_flags&StriContainerByteSearch::BYTESEARCH_CASE_INSENSITIVE));
+
+    // transformed keys must be stored separately
+    std::string table_data;
+    std::vector<size_t> table_offsets;
+    if (!keymaker.isIdentity()) {
+        table_offsets.resize(table_length+1, 0);
+        for (R_len_t j=0; j<table_length; ++j) {
+            if (!table_cont.isNA(j)) {
+                const char* s = table_cont.get(j).c_str();
+                R_len_t n = table_cont.get(j).length();
+                keymaker.make(s, n);
+                table_data.append(s, n);
+            }
+            table_offsets[j+1] = table_data.size();
+        }
+    }
+
+    StriInFixedHashTable hashtable(table_length);
+    for (R_len_t j=0; j<table_length; ++j) {
+        if (table_cont.isNA(j)) continue;
+        if (keymaker.isIdentity())
+            hashtable.insert(j, table_cont.get(j).c_str(), table_cont.get(j).length());
+        else
+            hashtable.insert(j, table_data.data()+table_offsets[j],
+                (R_len_t)(table_offsets[j+1]-table_offsets[j]));
+    }
+
+    SEXP ret;
+    STRI__PROTECT(ret = Rf_allocVector(INTSXP, str_length));
+    int* ret_tab = INTEGER(ret);
+
+    for (R_len_t i=0; i<str_length; ++i) {
+        if (str_cont.isNA(i)) {
+            ret_tab[i] = NA_INTEGER;
+            continue;
+        }
+
+        const char* s = str_cont.get(i).c_str();
+        R_len_t n = str_cont.get(i).length();
+        keymaker.make(s, n);
+
+        R_len_t j = hashtable.find(s, n);
+        ret_tab[i] = (j >= 0)?(j+1):nomatch_cur;  // 0-based index -> 1-based
+    }
+
+    STRI__UNPROTECT_ALL
+    return ret;
+    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
+}
@@ -34,6 +34,46 @@
 #include "stri_container_utf16.h"
 #include "stri_container_utf8.h"
 #include "stri_container_regex.h"
+#include "stri_parallel.h"
+
+/** help struct for stri_detect_regex: pattern detection
+ *  in parallel, each thread uses its own pattern container (and matchers)
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriDetectRegexWorker {
+    const StriContainerUTF16* str_cont;
+    StriParallelContainers<StriContainerRegexPattern>* pattern_conts;
+    bool negate;
+    int* ret_tab;
+
+    StriDetectRegexWorker(const StriContainerUTF16* _str_cont,
+        StriParallelContainers<StriContainerRegexPattern>* _pattern_conts,
+        bool _negate, int* _ret_tab)
+        : str_cont(_str_cont), pattern_conts(_pattern_conts),
+          negate(_negate), ret_tab(_ret_tab)
+    { }
+
+    void operator() (R_len_t k, int thread_id)
+    {
+        StriContainerRegexPattern& pattern_cont = (*pattern_conts)[thread_id];
+        R_len_t i = pattern_cont.vectorize_get(k);
+        if (str_cont->isNA(i) || pattern_cont.isNA(i) || pattern_cont.get(i).length() <= 0) {
+            ret_tab[i] = NA_LOGICAL;
+            return;
+        }
+
+        RegexMatcher *matcher = pattern_cont.getMatcher(i); // will be deleted automatically
+        matcher->reset(str_cont->get(i));
+
+        UErrorCode status = U_ZERO_ERROR;
+        ret_tab[i] = (int)matcher->find(status); // returns UBool
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+        if (negate) ret_tab[i] = !ret_tab[i];
+    }
+};
+
 
 /**
  * Detect if a pattern occurs in a string
@@ -69,6 +109,9 @@
  *
  * @version 1.4.7 (Marek Gagolewski, 2020-08-24)
  *    Use StriContainerRegexPattern::getRegexOptions
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    parallel execution (stri_options(threads=...)) if max_count < 0
  */
 SEXP stri_detect_regex(SEXP str, SEXP pattern, SEXP negate,
                        SEXP max_count, SEXP opts_regex)
@@ -92,6 +135,15 @@ SEXP stri_detect_regex(SEXP str, SEXP pattern, SEXP negate,
     STRI__PROTECT(ret = Rf_allocVector(LGLSXP, vectorize_length));
     int* ret_tab = LOGICAL(ret);
 
+    int nthreads = (max_count_1 < 0)?stri__parallel_get_num_threads(vectorize_length):1;
+    if (nthreads > 1) {
+        StriParallelContainers<StriContainerRegexPattern> pattern_conts(pattern_cont, nthreads);
+        StriDetectRegexWorker worker(&str_cont, &pattern_conts, negate_1, ret_tab);
+        stri__parallel_for(vectorize_length, nthreads, worker);
+        STRI__UNPROTECT_ALL
+        return ret;
+    }
+
     for (R_len_t i = pattern_cont.vectorize_init();
             i != pattern_cont.vectorize_end();
             i = pattern_cont.vectorize_next(i))
@@ -31,7 +31,7 @@
 
 
 #include "stri_stringi.h"
-#include "stri_container_utf16.h"
+#include "stri_container_utf8_indexable.h"
 #include "stri_container_regex.h"
 #include <deque>
 #include <utility>
@@ -47,10 +47,13 @@ using namespace std;
  * TODO: <refactor> use also in stri_locate_all_fixed etc.
  *
  * @version 1.7.1 (Marek Gagolewski, 2021-06-20)
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    use StriContainerUTF8_indexable (UTF-8 byte indexes)
  */
 SEXP stri__locate_get_fromto_matrix(
     deque< pair<R_len_t, R_len_t> >& occurrences,
-    StriContainerUTF16& str_cont,
+    StriContainerUTF8_indexable& str_cont,
     R_len_t i,
     bool omit_no_match1,
     bool get_length1
@@ -73,14 +76,13 @@ SEXP stri__locate_get_fromto_matrix(
         ans_tab[j+noccurrences] = match.second;
     }
 
-    // Adjust UChar index -> UChar32 index
-    // (1-2 byte UTF16 to 1 byte UTF32-code points)
+    // Adjust UTF8 byte index -> UChar32 index
     if (i < 0) {
         STRI_ASSERT(noccurrences == str_cont.get_nrecycle());
         for (i=0; i<noccurrences; ++i) {
             if (str_cont.isNA(i) || (ans_tab[i] == NA_INTEGER || ans_tab[i] < 0))
                 continue;
-            str_cont.UChar16_to_UChar32_index(
+            str_cont.UTF8_to_UChar32_index(
                 i, ans_tab+i,
                 ans_tab+i+noccurrences, 1,
                 1, // 0-based index -> 1-based
@@ -89,7 +91,7 @@ SEXP stri__locate_get_fromto_matrix(
         }
     }
     else {
-        str_cont.UChar16_to_UChar32_index(
+        str_cont.UTF8_to_UChar32_index(
             i, ans_tab,
             ans_tab+noccurrences, noccurrences,
             1, // 0-based index -> 1-based
@@ -143,6 +145,9 @@ SEXP stri__locate_get_fromto_matrix(
  *
  * @version 1.7.1 (Marek Gagolewski, 2021-06-29)
  *     get_length
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *     search in UTF-8 directly (UText)
  */
 SEXP stri_locate_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP opts_regex, SEXP capture_groups, SEXP get_length)
 {
@@ -155,8 +160,9 @@ SEXP stri_locate_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP opts
     PROTECT(pattern = stri__prepare_arg_string(pattern, "pattern")); // prepare string argument
     R_len_t vectorize_length = stri__recycling_rule(true, 2, LENGTH(str), LENGTH(pattern));
 
+    UText* str_text = NULL;
     STRI__ERROR_HANDLER_BEGIN(2)
-    StriContainerUTF16 str_cont(str, vectorize_length);
+    StriContainerUTF8_indexable str_cont(str, vectorize_length);
     StriContainerRegexPattern pattern_cont(pattern, vectorize_length, pattern_opts);
 
     SEXP ret;
@@ -192,7 +198,9 @@ SEXP stri_locate_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP opts
             cg_occurrences.resize(pattern_cur_groups);
 
         if (!(str_cont).isNA(i)) {
-            matcher->reset(str_cont.get(i));
+            str_text = utext_openUTF8(str_text, str_cont.get(i).c_str(), str_cont.get(i).length(), &status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            matcher->reset(str_text);
             int found = (int)matcher->find(status);
             STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
 
@@ -264,9 +272,13 @@ SEXP stri_locate_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP opts
     }
 
     stri__locate_set_dimnames_list(ret, get_length1);  // all matrices get from&to colnames
+    if (str_text) {
+        utext_close(str_text);
+        str_text = NULL;
+    }
     STRI__UNPROTECT_ALL
     return ret;
-    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
+    STRI__ERROR_HANDLER_END(if (str_text) utext_close(str_text);)
 }
 
 
@@ -298,6 +310,9 @@ SEXP stri_locate_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP opts
  *
  * @version 1.7.1 (Marek Gagolewski, 2021-06-29)
  *     get_length
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *     search in UTF-8 directly (UText)
  */
 SEXP stri__locate_firstlast_regex(
     SEXP str, SEXP pattern, SEXP opts_regex, bool first, bool capture_groups1, bool get_length1
@@ -309,8 +324,9 @@ SEXP stri__locate_firstlast_regex(
     StriRegexMatcherOptions pattern_opts =
         StriContainerRegexPattern::getRegexOptions(opts_regex);
 
+    UText* str_text = NULL;
     STRI__ERROR_HANDLER_BEGIN(2)
-    StriContainerUTF16 str_cont(str, vectorize_length);
+    StriContainerUTF8_indexable str_cont(str, vectorize_length);
     StriContainerRegexPattern pattern_cont(pattern, vectorize_length, pattern_opts);
 
     SEXP ret;
@@ -360,9 +376,11 @@ SEXP stri__locate_firstlast_regex(
             continue;
         }
 
-        matcher->reset(str_cont.get(i));
-
         UErrorCode status = U_ZERO_ERROR;
+        str_text = utext_openUTF8(str_text, str_cont.get(i).c_str(), str_cont.get(i).length(), &status);
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        matcher->reset(str_text);
+
         int m_res = (int)matcher->find(status);
         STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
         if (!m_res) {
@@ -406,8 +424,8 @@ SEXP stri__locate_firstlast_regex(
             if (!m_res) break;
         }
 
-        // Adjust UChar index -> UChar32 index (1-2 byte UTF16 to 1 byte UTF32-code points)
-        str_cont.UChar16_to_UChar32_index(
+        // Adjust UTF8 byte index -> UChar32 index
+        str_cont.UTF8_to_UChar32_index(
             i,
             ret_tab+i, ret_tab+i+vectorize_length, 1,
             1, // 0-based index -> 1-based
@@ -447,9 +465,13 @@ SEXP stri__locate_firstlast_regex(
     }
 
     stri__locate_set_dimnames_matrix(ret, get_length1);
+    if (str_text) {
+        utext_close(str_text);
+        str_text = NULL;
+    }
     STRI__UNPROTECT_ALL
     return ret;
-    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
+    STRI__ERROR_HANDLER_END(if (str_text) utext_close(str_text);)
 }
 
 
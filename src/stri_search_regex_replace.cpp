@@ -67,6 +67,10 @@
  *
  * @version 1.4.7 (Marek Gagolewski, 2020-08-24)
  *    Use StriContainerRegexPattern::getRegexOptions
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    search in UTF-8 directly (UText) and assemble the output in UTF-8
+ *    using StriRegexReplacement
  */
 SEXP stri__replace_allfirstlast_regex(SEXP str, SEXP pattern, SEXP replacement, SEXP opts_regex, int type)
 {
@@ -76,15 +80,21 @@ SEXP stri__replace_allfirstlast_regex(SEXP str, SEXP pattern, SEXP replacement,
     StriRegexMatcherOptions pattern_opts =
         StriContainerRegexPattern::getRegexOptions(opts_regex);
 
+    UText* str_text = NULL;
     STRI__ERROR_HANDLER_BEGIN(3)
     R_len_t vectorize_length = stri__recycling_rule(true, 3, LENGTH(str), LENGTH(pattern), LENGTH(replacement));
-    StriContainerUTF16 str_cont(str, vectorize_length, false); // writable
+    StriContainerUTF8 str_cont(str, vectorize_length);
     StriContainerRegexPattern pattern_cont(pattern, vectorize_length, pattern_opts);
     StriContainerUTF16 replacement_cont(replacement, vectorize_length);
 
     SEXP ret;
     STRI__PROTECT(ret = Rf_allocVector(STRSXP, vectorize_length));
 
+    StriRegexReplacement replacement_cur;
+    const UnicodeString* replacement_cur_str = NULL;  // what replacement_cur was compiled from
+    const UnicodeString* replacement_cur_pattern = NULL;
+    std::string buf;
+
     for (R_len_t i = pattern_cont.vectorize_init();
             i != pattern_cont.vectorize_end();
             i = pattern_cont.vectorize_next(i))
@@ -92,59 +102,82 @@ SEXP stri__replace_allfirstlast_regex(SEXP str, SEXP pattern, SEXP replacement,
         STRI__CONTINUE_ON_EMPTY_OR_NA_PATTERN(str_cont, pattern_cont,
                                               SET_STRING_ELT(ret, i, NA_STRING);)
 
-        RegexMatcher *matcher = pattern_cont.getMatcher(i); // will be deleted automatically
-        matcher->reset(str_cont.get(i));
-
         UErrorCode status = U_ZERO_ERROR;
-        if (replacement_cont.isNA(i)) {
-            int m_res = matcher->find(status);
-            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-            if (m_res)
-                str_cont.setNA(i);
+        RegexMatcher *matcher = pattern_cont.getMatcher(i); // will be deleted automatically
+        const char* str_cur_s = str_cont.get(i).c_str();
+        R_len_t str_cur_n = str_cont.get(i).length();
+        str_text = utext_openUTF8(str_text, str_cur_s, str_cur_n, &status);
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        matcher->reset(str_text);
+
+        int m_res = matcher->find(status);
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        if (!m_res) {  // no match - leave as-is
             SET_STRING_ELT(ret, i, str_cont.toR(i));
             continue;
         }
 
-        if (type == 0) { // all
-            str_cont.set(i, matcher->replaceAll(replacement_cont.get(i), status));
-            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        if (replacement_cont.isNA(i)) {
+            SET_STRING_ELT(ret, i, NA_STRING);
+            continue;
         }
-        else if (type == 1) { // first
-            str_cont.set(i, matcher->replaceFirst(replacement_cont.get(i), status));
+
+        if (type == -1) { // last
+            int start = matcher->start(status);
             STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-        }
-        else if (type == -1) { // end
-            int start = -1;
-            int end = -1;
             while (1) { // find last match
-                int m_res = matcher->find(status);
+                m_res = matcher->find(status);
                 STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
                 if (!m_res) break;
                 start = matcher->start(status);
                 STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-                end = matcher->end(status);
-                STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-            }
-            if (start >= 0) {
-                matcher->find(start, status); // go back
-                STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-                UnicodeString out;
-                matcher->appendReplacement(out, replacement_cont.get(i), status);
-                STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-                out.append(str_cont.get(i), end, str_cont.get(i).length()-end);
-                str_cont.set(i, out);
             }
+            matcher->find(start, status); // go back
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
         }
-        else {
+        else if (type != 0 && type != 1) {
             throw StriException(MSG__INTERNAL_ERROR);
         }
 
-        SET_STRING_ELT(ret, i, str_cont.toR(i));
+        // (only now, as invalid group references are reported on a match)
+        if (replacement_cur_str != &replacement_cont.get(i) ||
+                replacement_cur_pattern != &pattern_cont.get(i)) {
+            replacement_cur.compile(replacement_cont.get(i),
+                matcher->pattern(), matcher->groupCount(), status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            replacement_cur_str = &replacement_cont.get(i);
+            replacement_cur_pattern = &pattern_cont.get(i);
+        }
+
+        buf.clear();
+        int last_end = 0;
+        while (1) {
+            int start = matcher->start(status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            buf.append(str_cur_s+last_end, (size_t)(start-last_end));
+            replacement_cur.append(buf, str_cur_s, matcher, status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            last_end = matcher->end(status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+            if (type != 0) break;  // first or last
+
+            m_res = matcher->find(status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            if (!m_res) break;
+        }
+        buf.append(str_cur_s+last_end, (size_t)(str_cur_n-last_end));
+
+        SET_STRING_ELT(ret, i, Rf_mkCharLenCE(buf.data(), (int)buf.size(), CE_UTF8));
     }
 
+    if (str_text) {
+        utext_close(str_text);
+        str_text = NULL;
+    }
     STRI__UNPROTECT_ALL
     return ret;
-    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
+    STRI__ERROR_HANDLER_END(if (str_text) utext_close(str_text);)
 }
 
 
@@ -246,6 +279,230 @@ SEXP stri__replace_all_regex_no_vectorize_all(SEXP str, SEXP pattern, SEXP repla
 }
 
 
+/**
+ * Does a regex pattern (possibly) contain a back-reference,
+ * \n or \k<name>?
+ *
+ * Used by stri__replace_all_regex_single_pass, where the capture groups
+ * are renumbered.  This is a rough check (an escape in a character class
+ * is treated in the same way), but a false positive merely yields an error.
+ *
+ * @param pattern regex pattern
+ * @return true if the pattern contains a back-reference
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+bool stri__regex_has_backreference(const UnicodeString& pattern)
+{
+    int32_t n = pattern.length();
+    bool quoted = false;  // between \Q and \E
+    for (int32_t j=0; j+1<n; ++j) {
+        if (pattern.charAt(j) != 0x5c /* backslash */)
+            continue;
+
+        UChar c = pattern.charAt(j+1);
+        if (quoted) {
+            if (c == 0x45 /* E */) {
+                quoted = false;
+                ++j;
+            }
+        }
+        else {
+            if (c == 0x51 /* Q */)
+                quoted = true;
+            else if (c == 0x6b /* k */ || (u_isdigit(c) && u_charDigitValue(c) > 0))
+                return true;  // (\0 starts an octal escape)
+            ++j;  // skip the escaped character
+        }
+    }
+    return false;
+}
+
+
+/**
+ * Replace all occurrences of any of the regex patterns in a single pass
+ *
+ * The patterns are combined into one alternation, (p1)|(p2)|..., which
+ * is searched for once.  At each position, the first pattern (in the order
+ * given) that matches is used; and the matched text is not searched
+ * in again (unlike in stri__replace_all_regex_no_vectorize_all).
+ * The capture group references in the replacement strings refer to
+ * each pattern's own capture groups.
+ *
+ * @param str strings to search in
+ * @param pattern regex patterns to search for
+ * @param replacement replacements
+ * @param opts_regex list
+ * @return character vector
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+SEXP stri__replace_all_regex_single_pass(SEXP str, SEXP pattern, SEXP replacement, SEXP opts_regex)
+{
+    PROTECT(str          = stri__prepare_arg_string(str, "str"));
+
+    // if str_n is 0, then return an empty vector
+    R_len_t str_n = LENGTH(str);
+    if (str_n <= 0) {
+        UNPROTECT(1);
+        return stri__vector_empty_strings(0);
+    }
+
+    PROTECT(pattern      = stri__prepare_arg_string(pattern, "pattern"));
+    PROTECT(replacement  = stri__prepare_arg_string(replacement, "replacement"));
+    StriRegexMatcherOptions pattern_opts =
+        StriContainerRegexPattern::getRegexOptions(opts_regex);
+
+    R_len_t pattern_n = LENGTH(pattern);
+    R_len_t replacement_n = LENGTH(replacement);
+    if (pattern_n < replacement_n || pattern_n <= 0 || replacement_n <= 0) {
+        UNPROTECT(3);
+        Rf_error(MSG__WARN_RECYCLING_RULE2);
+    }
+    else if (pattern_n % replacement_n != 0)
+        Rf_warning(MSG__WARN_RECYCLING_RULE);
+
+    if (pattern_n == 1) {// this will be much faster:
+        SEXP ret;
+        PROTECT(ret = stri__replace_allfirstlast_regex(str, pattern, replacement, opts_regex, 0));
+        UNPROTECT(4);
+        return ret;
+    }
+
+    UText* str_text = NULL;
+    STRI__ERROR_HANDLER_BEGIN(3)
+    StriContainerUTF8 str_cont(str, str_n);
+    StriContainerRegexPattern pattern_cont(pattern, pattern_n, pattern_opts);
+    StriContainerUTF16 replacement_cont(replacement, pattern_n);
+
+    // literal patterns are quoted, so that they can be combined
+    bool literal = ((pattern_opts.flags & UREGEX_LITERAL) != 0);
+    StriRegexMatcherOptions combined_opts = pattern_opts;
+    combined_opts.flags &= ~(uint32_t)UREGEX_LITERAL;
+
+    UnicodeString combined;
+    std::vector<int32_t> branch_group(pattern_n);  // the group wrapping each pattern
+    std::vector<StriRegexReplacement> branch_replacement(pattern_n);
+    std::vector<UErrorCode> branch_status(pattern_n, U_ZERO_ERROR);
+    int32_t ngroups = 0;
+    for (R_len_t k = 0; k<pattern_n; ++k)
+    {
+        if (pattern_cont.isNA(k)) {
+            STRI__UNPROTECT_ALL
+            return stri__vector_NA_strings(str_n);
+        }
+        else if (pattern_cont.get(k).length() <= 0) {
+            Rf_warning(MSG__EMPTY_SEARCH_PATTERN_UNSUPPORTED);
+            STRI__UNPROTECT_ALL
+            return stri__vector_NA_strings(str_n);
+        }
+
+        RegexMatcher *matcher = pattern_cont.getMatcher(k); // will be deleted automatically
+        const UnicodeString& pattern_cur = pattern_cont.get(k);
+
+        if (k > 0) combined.append((UChar)0x7c /* | */);
+        combined.append((UChar)0x28 /* ( */);
+        if (literal) {
+            UnicodeString quoted(pattern_cur);
+            quoted.findAndReplace(UnicodeString("\\E"), UnicodeString("\\E\\\\E\\Q"));
+            combined.append(UnicodeString("\\Q")).append(quoted).append(UnicodeString("\\E"));
+        }
+        else {
+            if (stri__regex_has_backreference(pattern_cur))
+                throw StriException(MSG__REGEX_SINGLE_PASS_UNSUPPORTED);
+            combined.append(pattern_cur);
+        }
+        if ((pattern_opts.flags & UREGEX_COMMENTS) != 0)
+            combined.append((UChar)0x0a /* end a possible # comment */);
+        combined.append((UChar)0x29 /* ) */);
+
+        branch_group[k] = ++ngroups;
+        ngroups += matcher->groupCount();
+
+        // invalid group references are reported only on a match (as usual)
+        if (!replacement_cont.isNA(k))
+            branch_replacement[k].compile(replacement_cont.get(k),
+                matcher->pattern(), matcher->groupCount(), branch_status[k]);
+    }
+
+    std::string combined_s;
+    combined.toUTF8String(combined_s);
+    SEXP combined_r;
+    STRI__PROTECT(combined_r = Rf_ScalarString(
+        Rf_mkCharLenCE(combined_s.data(), (int)combined_s.size(), CE_UTF8)));
+    StriContainerRegexPattern combined_cont(combined_r, 1, combined_opts);
+    RegexMatcher *matcher = combined_cont.getMatcher(0); // will be deleted automatically
+    if (matcher->groupCount() != ngroups)  // e.g., an unterminated \Q
+        throw StriException(MSG__REGEX_SINGLE_PASS_UNSUPPORTED);
+
+    SEXP ret;
+    STRI__PROTECT(ret = Rf_allocVector(STRSXP, str_n));
+
+    std::string buf;
+    for (R_len_t i = 0; i<str_n; ++i)
+    {
+        if (str_cont.isNA(i)) {
+            SET_STRING_ELT(ret, i, NA_STRING);
+            continue;
+        }
+
+        UErrorCode status = U_ZERO_ERROR;
+        const char* str_cur_s = str_cont.get(i).c_str();
+        R_len_t str_cur_n = str_cont.get(i).length();
+        str_text = utext_openUTF8(str_text, str_cur_s, str_cur_n, &status);
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        matcher->reset(str_text);
+
+        buf.clear();
+        int last_end = 0;
+        bool found = false;
+        bool is_na = false;
+        while (1) {
+            int m_res = matcher->find(status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            if (!m_res) break;
+            found = true;
+
+            R_len_t k = 0;  // which pattern has matched?
+            while (k < pattern_n-1 && matcher->start(branch_group[k], status) < 0)
+                ++k;
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+            if (replacement_cont.isNA(k)) {
+                is_na = true;
+                break;
+            }
+            STRI__CHECKICUSTATUS_THROW(branch_status[k], {/* do nothing special on err */})
+
+            int start = matcher->start(status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            buf.append(str_cur_s+last_end, (size_t)(start-last_end));
+            branch_replacement[k].append(buf, str_cur_s, matcher, status, branch_group[k]);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            last_end = matcher->end(status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        }
+
+        if (is_na)
+            SET_STRING_ELT(ret, i, NA_STRING);
+        else if (!found)  // leave as-is
+            SET_STRING_ELT(ret, i, str_cont.toR(i));
+        else {
+            buf.append(str_cur_s+last_end, (size_t)(str_cur_n-last_end));
+            SET_STRING_ELT(ret, i, Rf_mkCharLenCE(buf.data(), (int)buf.size(), CE_UTF8));
+        }
+    }
+
+    if (str_text) {
+        utext_close(str_text);
+        str_text = NULL;
+    }
+    STRI__UNPROTECT_ALL
+    return ret;
+    STRI__ERROR_HANDLER_END(if (str_text) utext_close(str_text);)
+}
+
+
 // version alpha == to slow == too many toutf16 conversions
 //{
 //   PROTECT(pattern      = stri__prepare_arg_string(pattern, "pattern"));
@@ -284,17 +541,24 @@ SEXP stri__replace_all_regex_no_vectorize_all(SEXP str, SEXP pattern, SEXP repla
  * @param pattern regex patterns to search for
  * @param replacement replacements
  * @param opts_regex list
+ * @param single_pass single logical value; whether the patterns should be
+ *    combined into one if vectorize_all is FALSE
  * @return character vector
  *
  * @version 0.1-?? (Marek Gagolewski, 2013-06-21)
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-01)
  *          vectorize_all argument added
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *          single_pass argument added
  */
-SEXP stri_replace_all_regex(SEXP str, SEXP pattern, SEXP replacement, SEXP vectorize_all, SEXP opts_regex)
+SEXP stri_replace_all_regex(SEXP str, SEXP pattern, SEXP replacement, SEXP vectorize_all, SEXP opts_regex, SEXP single_pass)
 {
     if (stri__prepare_arg_logical_1_notNA(vectorize_all, "vectorize_all"))
         return stri__replace_allfirstlast_regex(str, pattern, replacement, opts_regex, 0);
+    else if (stri__prepare_arg_logical_1_notNA(single_pass, "single_pass"))
+        return stri__replace_all_regex_single_pass(str, pattern, replacement, opts_regex);
     else
         return stri__replace_all_regex_no_vectorize_all(str, pattern, replacement, opts_regex);
 }
@@ -40,12 +40,22 @@
 #include <deque>
 #include <algorithm>
 #include <set>
+#include <unordered_set>
+#include <unicode/uiter.h>
 
 
 # define STRI_SORTRANKORDER_SORT  1
 # define STRI_SORTRANKORDER_RANK  2
 # define STRI_SORTRANKORDER_ORDER 3
 
+// use sort keys in stri_order & co. if there are at least that many strings:
+# define STRI__SORT_KEYS_MIN_LENGTH 256
+
+// radix sort: switch to comparison-based sorting for buckets this small...
+# define STRI__SORT_KEYS_RADIX_MIN_BUCKET 32
+// ...or if the common prefix is this long
+# define STRI__SORT_KEYS_RADIX_MAX_DEPTH 64
+
 /** help struct for stri_order **/
 struct StriSortComparer {
     StriContainerUTF8* cont;
@@ -80,6 +90,205 @@ struct StriSortComparer {
 };
 
 
+/** help class for stri_order & co.:
+ *  collation sort keys of (some of) the strings in a container,
+ *  stored in a single contiguous arena
+ *
+ * Sort keys are NUL-terminated byte strings such that comparing two keys
+ * with strcmp() is equivalent to comparing the corresponding strings
+ * with the collator; they are generated only once per string.
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriSortKeys {
+
+private:
+
+    std::vector<char> arena;
+    std::vector<size_t> offsets; ///< offsets[i] - where the i-th key begins
+
+    struct Comparer {
+        const StriSortKeys* keys;
+        size_t depth;
+        bool decreasing;
+
+        Comparer(const StriSortKeys* _keys, size_t _depth, bool _decreasing)
+            : keys(_keys), depth(_depth), decreasing(_decreasing) { }
+
+        bool operator() (int a, int b) const
+        {
+            int ret = strcmp(keys->get(a)+depth, keys->get(b)+depth);
+            return (decreasing)?(ret > 0):(ret < 0);
+        }
+    };
+
+
+    /** stable MSD radix sort of the keys indexed by a[0..n-1];
+     *  the first depth bytes are assumed to be equal
+     */
+    void radixSort(int* a, int* tmp, R_len_t n, size_t depth, bool decreasing) const
+    {
+        if (n < STRI__SORT_KEYS_RADIX_MIN_BUCKET || depth >= STRI__SORT_KEYS_RADIX_MAX_DEPTH) {
+            std::stable_sort(a, a+n, Comparer(this, depth, decreasing));
+            return;
+        }
+
+        // byte 0 = the key has ended (all such keys are equal)
+        R_len_t count[256];
+        R_len_t start[256];
+        for (int b=0; b<256; ++b) count[b] = 0;
+        for (R_len_t i=0; i<n; ++i)
+            ++count[(uint8_t)get(a[i])[depth]];
+
+        R_len_t cur = 0;
+        for (int j=0; j<256; ++j) {
+            int b = (decreasing)?(255-j):j;  // decreasing: 255, ..., 1, 0
+            start[b] = cur;
+            cur += count[b];
+        }
+
+        R_len_t pos[256];
+        for (int b=0; b<256; ++b) pos[b] = start[b];
+        for (R_len_t i=0; i<n; ++i)
+            tmp[pos[(uint8_t)get(a[i])[depth]]++] = a[i];
+        std::copy(tmp, tmp+n, a);
+
+        for (int b=1; b<256; ++b) {
+            if (count[b] > 1)
+                radixSort(a+start[b], tmp+start[b], count[b], depth+1, decreasing);
+        }
+    }
+
+
+public:
+
+    /** Generate the sort keys
+     *
+     * @param cont strings
+     * @param col collator
+     * @param which indexes of the strings whose keys are to be generated
+     */
+    StriSortKeys(StriContainerUTF8* cont, UCollator* col, const std::vector<int>& which)
+        : offsets(cont->get_n(), 0)
+    {
+        std::vector<UChar> buf16(256);
+        std::vector<uint8_t> buf8(1024);
+        arena.reserve(which.size()*16);
+        for (size_t k=0; k<which.size(); ++k) {
+            int i = which[k];
+
+            // ucol_getSortKey needs UTF-16
+            UErrorCode status = U_ZERO_ERROR;
+            int32_t len16 = 0;
+            u_strFromUTF8(buf16.data(), (int32_t)buf16.size(), &len16,
+                cont->get(i).c_str(), cont->get(i).length(), &status);
+            if (status == U_BUFFER_OVERFLOW_ERROR) {
+                buf16.resize(len16+1);
+                status = U_ZERO_ERROR;
+                u_strFromUTF8(buf16.data(), (int32_t)buf16.size(), &len16,
+                    cont->get(i).c_str(), cont->get(i).length(), &status);
+            }
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+            int32_t key_size = ucol_getSortKey(col, buf16.data(), len16,
+                buf8.data(), (int32_t)buf8.size());
+            if ((size_t)key_size > buf8.size()) {
+                // reallocate a larger buffer and retry
+                buf8.resize(key_size+100);
+                key_size = ucol_getSortKey(col, buf16.data(), len16,
+                    buf8.data(), (int32_t)buf8.size());
+            }
+            if (key_size <= 0)
+                throw StriException(MSG__INTERNAL_ERROR);
+
+            // key_size includes the NUL terminator
+            offsets[i] = arena.size();
+            arena.insert(arena.end(), (const char*)buf8.data(), (const char*)buf8.data()+key_size);
+        }
+    }
+
+    inline const char* get(int i) const {
+        return arena.data()+offsets[i];
+    }
+
+    /** Stable sort of order w.r.t. the keys */
+    void sort(std::vector<int>& order, bool decreasing) const
+    {
+        if (order.size() <= 1) return;
+        std::vector<int> tmp(order.size());
+        radixSort(order.data(), tmp.data(), (R_len_t)order.size(), 0, decreasing);
+    }
+};
+
+
+/** help struct for stri_unique and stri_duplicated*:
+ *  hashes the ICU sort keys; strings that compare equal (w.r.t. col)
+ *  have identical sort keys and hence equal hashes
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriSortKeyHash {
+    StriContainerUTF8* cont;
+    UCollator* col;
+
+    StriSortKeyHash(StriContainerUTF8* _cont, UCollator* _col)
+    {
+        this->cont = _cont;
+        this->col = _col;
+    }
+
+    size_t operator() (int a) const
+    {
+        UCharIterator iter;
+        uiter_setUTF8(&iter, cont->get(a).c_str(), cont->get(a).length());
+
+        // the sort key is generated in chunks, so that
+        // there is no need to store it as a whole
+        uint32_t state[2] = {0, 0};
+        uint8_t buf[256];
+        uint64_t hash = 14695981039346656037ULL; // FNV-1a
+        int32_t count;
+        do {
+            UErrorCode status = U_ZERO_ERROR;
+            count = ucol_nextSortKeyPart(col, &iter, state, buf, (int32_t)sizeof(buf), &status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            for (int32_t k=0; k<count; ++k) {
+                hash ^= (uint64_t)buf[k];
+                hash *= 1099511628211ULL;
+            }
+        } while (count == (int32_t)sizeof(buf));
+
+        return (size_t)hash;
+    }
+};
+
+
+/** help struct for stri_unique and stri_duplicated* **/
+struct StriSortKeyEqual {
+    StriContainerUTF8* cont;
+    UCollator* col;
+
+    StriSortKeyEqual(StriContainerUTF8* _cont, UCollator* _col)
+    {
+        this->cont = _cont;
+        this->col = _col;
+    }
+
+    bool operator() (int a, int b) const
+    {
+        UErrorCode status = U_ZERO_ERROR;
+        int ret = (int)ucol_strcollUTF8(col,
+            cont->get(a).c_str(), cont->get(a).length(),
+            cont->get(b).c_str(), cont->get(b).length(), &status);
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        return ret == UCOL_EQUAL;
+    }
+};
+
+
+typedef std::unordered_set<int,StriSortKeyHash,StriSortKeyEqual> StriSortKeySet;
+
+
 /** Sort, rank, or generate an ordering permutation
  *
  * @param str character vector
@@ -115,6 +324,9 @@ struct StriSortComparer {
  *
  * @version 1.6.1 (Marek Gagolewski, 2021-04-30)
  *    rank
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    radix-sort the collation sort keys for longer vectors
  */
 SEXP stri_order_rank_or_sort(SEXP str, SEXP decreasing, SEXP na_last,
                         SEXP opts_collator, int _type)
@@ -140,6 +352,7 @@ SEXP stri_order_rank_or_sort(SEXP str, SEXP decreasing, SEXP na_last,
     // if prepare_arg had failed, we would have a mem leak
     UCollator* col = NULL;
     col = stri__ucol_open(opts_collator);
+    StriSortKeys* keys = NULL;
 
 
     STRI__ERROR_HANDLER_BEGIN(2)
@@ -162,11 +375,17 @@ SEXP stri_order_rank_or_sort(SEXP str, SEXP decreasing, SEXP na_last,
     order.resize(k); // this should be faster than creating a separate deque (not tested)
 
 
-    // TO DO: collation-based cmp: think of using sort keys...
-    // however,  it's  very fast already now.
-
-    StriSortComparer comp(&str_cont, col, decr);
-    std::stable_sort(order.begin(), order.end(), comp);
+    // collation-based cmp: for longer vectors, generate the sort keys
+    // once and radix-sort them instead of calling the collator
+    // O(n log n) times
+    if (k >= STRI__SORT_KEYS_MIN_LENGTH) {
+        keys = new StriSortKeys(&str_cont, col, order);
+        keys->sort(order, decr);
+    }
+    else {
+        StriSortComparer comp(&str_cont, col, decr);
+        std::stable_sort(order.begin(), order.end(), comp);
+    }
 
 
     SEXP ret;
@@ -222,7 +441,12 @@ SEXP stri_order_rank_or_sort(SEXP str, SEXP decreasing, SEXP na_last,
         for (std::vector<int>::iterator it=order.begin(); it!=order.end(); ++it) {
             cur_idx = *it;
 
-            if (j_first > 1) {
+            if (j_first > 1 && keys) {
+                if (0 != strcmp(keys->get(last_idx), keys->get(cur_idx)))
+                    j_min = j_first;
+                // else reuse j_min == a tie.
+            }
+            else if (j_first > 1) {
                 UErrorCode status = U_ZERO_ERROR;
                 if (
                     0 != (int)ucol_strcollUTF8(
@@ -246,6 +470,11 @@ SEXP stri_order_rank_or_sort(SEXP str, SEXP decreasing, SEXP na_last,
         }
     }
 
+    if (keys) {
+        delete keys;
+        keys = NULL;
+    }
+
     if (col) {
         ucol_close(col);
         col = NULL;
@@ -255,6 +484,10 @@ SEXP stri_order_rank_or_sort(SEXP str, SEXP decreasing, SEXP na_last,
     return ret;
 
     STRI__ERROR_HANDLER_END({
+        if (keys) {
+            delete keys;
+            keys = NULL;
+        }
         if (col) {
             ucol_close(col);
             col = NULL;
@@ -337,6 +570,9 @@ SEXP stri_rank(SEXP str, SEXP opts_collator)
  * @version 1.8.9.9001 (Travers Ching, 2026-08-01)
  *    the CHARSXPs gathered while looking for unique elements were not
  *    PROTECTed from gc; store the corresponding indexes instead
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    use a hash table over ICU sort keys instead of a binary tree
  */
 SEXP stri_unique(SEXP str, SEXP opts_collator)
 {
@@ -352,8 +588,8 @@ SEXP stri_unique(SEXP str, SEXP opts_collator)
     R_len_t vectorize_length = LENGTH(str);
     StriContainerUTF8 str_cont(str, vectorize_length);
 
-    StriSortComparer comp(&str_cont, col, true);
-    set<int,StriSortComparer> uniqueset(comp);
+    StriSortKeySet uniqueset(vectorize_length,
+        StriSortKeyHash(&str_cont, col), StriSortKeyEqual(&str_cont, col));
 
     // gather the indexes, not the CHARSXPs themselves: the latter would not
     // be PROTECTed from gc (str_cont.toR() may allocate, e.g., if the input
@@ -368,7 +604,7 @@ SEXP stri_unique(SEXP str, SEXP opts_collator)
             }
         }
         else {
-            pair<set<int,StriSortComparer>::iterator,bool> result = uniqueset.insert(i);
+            pair<StriSortKeySet::iterator,bool> result = uniqueset.insert(i);
             if (result.second) {
                 temp.push_back(i);
             }
@@ -413,6 +649,9 @@ SEXP stri_unique(SEXP str, SEXP opts_collator)
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-04)
  *    Issue #112: str_prepare_arg* retvals were not PROTECTed from gc
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    use a hash table over ICU sort keys instead of a binary tree
  */
 SEXP stri_duplicated(SEXP str, SEXP fromLast, SEXP opts_collator)
 {
@@ -429,8 +668,8 @@ SEXP stri_duplicated(SEXP str, SEXP fromLast, SEXP opts_collator)
     R_len_t vectorize_length = LENGTH(str);
     StriContainerUTF8 str_cont(str, vectorize_length);
 
-    StriSortComparer comp(&str_cont, col, true);
-    set<int,StriSortComparer> uniqueset(comp);
+    StriSortKeySet uniqueset(vectorize_length,
+        StriSortKeyHash(&str_cont, col), StriSortKeyEqual(&str_cont, col));
 
     bool was_na = false;
     SEXP ret;
@@ -445,7 +684,7 @@ SEXP stri_duplicated(SEXP str, SEXP fromLast, SEXP opts_collator)
                     was_na = true;
             }
             else {
-                pair<set<int,StriSortComparer>::iterator,bool> result = uniqueset.insert(i);
+                pair<StriSortKeySet::iterator,bool> result = uniqueset.insert(i);
                 ret_tab[i] = !result.second;
             }
         }
@@ -458,7 +697,7 @@ SEXP stri_duplicated(SEXP str, SEXP fromLast, SEXP opts_collator)
                     was_na = true;
             }
             else {
-                pair<set<int,StriSortComparer>::iterator,bool> result = uniqueset.insert(i);
+                pair<StriSortKeySet::iterator,bool> result = uniqueset.insert(i);
                 ret_tab[i] = !result.second;
             }
         }
@@ -496,6 +735,9 @@ SEXP stri_duplicated(SEXP str, SEXP fromLast, SEXP opts_collator)
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-04)
  *    Issue #112: str_prepare_arg* retvals were not PROTECTed from gc
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    use a hash table over ICU sort keys instead of a binary tree
  */
 SEXP stri_duplicated_any(SEXP str, SEXP fromLast, SEXP opts_collator)
 {
@@ -512,8 +754,8 @@ SEXP stri_duplicated_any(SEXP str, SEXP fromLast, SEXP opts_collator)
     R_len_t vectorize_length = LENGTH(str);
     StriContainerUTF8 str_cont(str, vectorize_length);
 
-    StriSortComparer comp(&str_cont, col, true);
-    set<int,StriSortComparer> uniqueset(comp);
+    StriSortKeySet uniqueset(vectorize_length,
+        StriSortKeyHash(&str_cont, col), StriSortKeyEqual(&str_cont, col));
 
     bool was_na = false;
     SEXP ret;
@@ -532,7 +774,7 @@ SEXP stri_duplicated_any(SEXP str, SEXP fromLast, SEXP opts_collator)
                 }
             }
             else {
-                pair<set<int,StriSortComparer>::iterator,bool> result = uniqueset.insert(i);
+                pair<StriSortKeySet::iterator,bool> result = uniqueset.insert(i);
                 if (!result.second) {
                     ret_tab[0] = i+1;
                     break;
@@ -551,7 +793,7 @@ SEXP stri_duplicated_any(SEXP str, SEXP fromLast, SEXP opts_collator)
                 }
             }
             else {
-                pair<set<int,StriSortComparer>::iterator,bool> result = uniqueset.insert(i);
+                pair<StriSortKeySet::iterator,bool> result = uniqueset.insert(i);
                 if (!result.second) {
                     ret_tab[0] = i+1;
                     break;
@@ -66,6 +66,7 @@ const R_CallMethodDef cCallMethods[] = {
     STRI__MK_CALL("C_stri_count_boundaries",             stri_count_boundaries,           2),
     STRI__MK_CALL("C_stri_count_charclass",              stri_count_charclass,            2),
     STRI__MK_CALL("C_stri_count_fixed",                  stri_count_fixed,                3),
+    STRI__MK_CALL("C_stri_count_dict",                   stri_count_dict,                 3),
     STRI__MK_CALL("C_stri_count_coll",                   stri_count_coll,                 3),
     STRI__MK_CALL("C_stri_count_regex",                  stri_count_regex,                3),
     STRI__MK_CALL("C_stri_datetime_symbols",             stri_datetime_symbols,           3),
@@ -78,12 +79,13 @@ const R_CallMethodDef cCallMethods[] = {
     STRI__MK_CALL("C_stri_datetime_add",                 stri_datetime_add,               5),
     STRI__MK_CALL("C_stri_detect_charclass",             stri_detect_charclass,           4),
     STRI__MK_CALL("C_stri_detect_coll",                  stri_detect_coll,                5),
+    STRI__MK_CALL("C_stri_detect_dict",                  stri_detect_dict,                4),
     STRI__MK_CALL("C_stri_detect_fixed",                 stri_detect_fixed,               5),
     STRI__MK_CALL("C_stri_detect_regex",                 stri_detect_regex,               5),
     STRI__MK_CALL("C_stri_dup",                          stri_dup,                        2),
     STRI__MK_CALL("C_stri_duplicated",                   stri_duplicated,                 3),
     STRI__MK_CALL("C_stri_duplicated_any",               stri_duplicated_any,             3),
-    STRI__MK_CALL("C_stri_enc_detect",                   stri_enc_detect,                 2),
+    STRI__MK_CALL("C_stri_enc_detect",                   stri_enc_detect,                 3),
     STRI__MK_CALL("C_stri_enc_detect2",                  stri_enc_detect2,                2),
     STRI__MK_CALL("C_stri_enc_isutf8",                   stri_enc_isutf8,                 1),
     STRI__MK_CALL("C_stri_enc_isutf16le",                stri_enc_isutf16le,              1),
@@ -120,6 +122,7 @@ const R_CallMethodDef cCallMethods[] = {
     STRI__MK_CALL("C_stri_extract_last_regex",           stri_extract_last_regex,         3),
     STRI__MK_CALL("C_stri_extract_all_regex",            stri_extract_all_regex,          5),
     STRI__MK_CALL("C_stri_flatten",                      stri_flatten,                    4),
+    STRI__MK_CALL("C_stri_in_fixed",                     stri_in_fixed,                   5),
     STRI__MK_CALL("C_stri_info",                         stri_info,                       0),
     STRI__MK_CALL("C_stri_isempty",                      stri_isempty,                    1),
     STRI__MK_CALL("C_stri_join",                         stri_join,                       4),
@@ -149,6 +152,7 @@ const R_CallMethodDef cCallMethods[] = {
     STRI__MK_CALL("C_stri_match_last_regex",             stri_match_last_regex,           4),
     STRI__MK_CALL("C_stri_match_all_regex",              stri_match_all_regex,            5),
     STRI__MK_CALL("C_stri_numbytes",                     stri_numbytes,                   1),
+    STRI__MK_CALL("C_stri_options",                      stri_options,                    1),
     STRI__MK_CALL("C_stri_order",                        stri_order,                      4),
     STRI__MK_CALL("C_stri_rank",                         stri_rank,                       2),
     STRI__MK_CALL("C_stri_sort",                         stri_sort,                       4),
@@ -165,15 +169,19 @@ const R_CallMethodDef cCallMethods[] = {
     STRI__MK_CALL("C_stri_prepare_arg_logical_1",        stri_prepare_arg_logical_1,      2),
     STRI__MK_CALL("C_stri_rand_shuffle",                 stri_rand_shuffle,               1),
     STRI__MK_CALL("C_stri_rand_strings",                 stri_rand_strings,               3),
+    STRI__MK_CALL("C_stri_read_lines_open",              stri_read_lines_open,            2),
+    STRI__MK_CALL("C_stri_read_lines_push",              stri_read_lines_push,            3),
+    STRI__MK_CALL("C_stri_read_raw_file",                stri_read_raw_file,              1),
     STRI__MK_CALL("C_stri_replace_na",                   stri_replace_na,                 2),
     STRI__MK_CALL("C_stri_replace_rstr",                 stri_replace_rstr,               1),
     STRI__MK_CALL("C_stri_replace_all_fixed",            stri_replace_all_fixed,          5),
     STRI__MK_CALL("C_stri_replace_first_fixed",          stri_replace_first_fixed,        4),
     STRI__MK_CALL("C_stri_replace_last_fixed",           stri_replace_last_fixed,         4),
+    STRI__MK_CALL("C_stri_replace_all_dict",             stri_replace_all_dict,           4),
     STRI__MK_CALL("C_stri_replace_all_coll",             stri_replace_all_coll,           5),
     STRI__MK_CALL("C_stri_replace_first_coll",           stri_replace_first_coll,         4),
     STRI__MK_CALL("C_stri_replace_last_coll",            stri_replace_last_coll,          4),
-    STRI__MK_CALL("C_stri_replace_all_regex",            stri_replace_all_regex,          5),
+    STRI__MK_CALL("C_stri_replace_all_regex",            stri_replace_all_regex,          6),
     STRI__MK_CALL("C_stri_replace_first_regex",          stri_replace_first_regex,        4),
     STRI__MK_CALL("C_stri_replace_last_regex",           stri_replace_last_regex,         4),
     STRI__MK_CALL("C_stri_replace_all_charclass",        stri_replace_all_charclass,      5),
@@ -221,6 +229,7 @@ const R_CallMethodDef cCallMethods[] = {
     STRI__MK_CALL("C_stri_trans_isnfkc_casefold",        stri_trans_isnfkc_casefold,      1),
     STRI__MK_CALL("C_stri_trans_general",                stri_trans_general,              4),
     STRI__MK_CALL("C_stri_trans_list",                   stri_trans_list,                 0),
+    STRI__MK_CALL("C_stri_trans_precompile",             stri_trans_precompile,           3),
     STRI__MK_CALL("C_stri_trans_nfc",                    stri_trans_nfc,                  1),
     STRI__MK_CALL("C_stri_trans_nfd",                    stri_trans_nfd,                  1),
     STRI__MK_CALL("C_stri_trans_nfkc",                   stri_trans_nfkc,                 1),
@@ -237,6 +246,8 @@ const R_CallMethodDef cCallMethods[] = {
     STRI__MK_CALL("C_stri_unique",                       stri_unique,                     2),
     STRI__MK_CALL("C_stri_width",                        stri_width,                      1),
     STRI__MK_CALL("C_stri_wrap",                         stri_wrap,                      10),
+    STRI__MK_CALL("C_stri_write_lines_open",             stri_write_lines_open,           5),
+    STRI__MK_CALL("C_stri_write_lines_push",             stri_write_lines_push,           3),
     // the list must be NULL-terminated:
     {NULL,                           NULL,                  0}
 
@@ -335,18 +346,19 @@ extern "C" void R_init_stringi(DllInfo* dll)
 }
 
 
-#ifndef NDEBUG
-
-#include <unicode/uclean.h>
-
 /**
  * Library cleanup
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    dispose of the cached ICU objects
  */
 extern "C" void  R_unload_stringi(DllInfo*)
 {
+    stri__caches_clear();
+
+#ifndef NDEBUG
     // see http://bugs.icu-project.org/trac/ticket/10897
     // and https://github.com/Rexamine/stringi/issues/78
     u_cleanup();
-}
-
 #endif
+}
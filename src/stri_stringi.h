@@ -54,10 +54,18 @@ SEXP    stri__matrix_NA_INTEGER(R_len_t nrow, R_len_t ncol, int filler=NA_INTEGE
 SEXP    stri__matrix_NA_STRING(R_len_t nrow, R_len_t ncol);
 int     stri__match_arg(const char* option, const char** set);
 
+// ICU_settings.cpp:
+void    stri__caches_clear();
+
 // collator.cpp:
 struct UCollator;
 UCollator* stri__ucol_open(SEXP opts_collator);
 
+// encoding_validation.cpp:
+bool    stri__utf8_is_valid(const char* s, R_len_t n);
+bool    stri__ascii_is_valid(const char* s, R_len_t n);
+R_len_t stri__utf8_count_codepoints(const char* s, R_len_t n);
+
 // length.cpp
 R_len_t stri__numbytes_max(SEXP str);
 int     stri__width_char(UChar32 c);
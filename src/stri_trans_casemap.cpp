@@ -34,7 +34,11 @@
 #include "stri_container_utf8.h"
 #include "stri_string8buf.h"
 #include "stri_brkiter.h"
+#include "stri_parallel.h"
 #include <unicode/ucasemap.h>
+#include <unicode/casemap.h>
+#include <vector>
+#include <string>
 
 
 #define STRI_CASEMAP_TOLOWER   1
@@ -53,29 +57,21 @@
  * @version 0.4-1 (Marek Gagolewski, 2014-12-03)
  *    separated from stri_trans_casemap;
  *    use StriUBreakIterator
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    use CaseMap with a (cached) StriRuleBasedBreakIterator
  */
 SEXP stri_trans_totitle(SEXP str, SEXP opts_brkiter) {
     StriBrkIterOptions opts_brkiter2(opts_brkiter, "word");
     PROTECT(str = stri__prepare_arg_string(str, "str")); // prepare string argument
 
-// version 0.2-1 - Does not work with ICU 4.8 (but we require ICU >= 50)
-    UCaseMap* ucasemap = NULL;
-
     STRI__ERROR_HANDLER_BEGIN(1)
-    StriUBreakIterator brkiter(opts_brkiter2);
-
+    StriRuleBasedBreakIterator brkiter(opts_brkiter2);
+    // CaseMap::utf8ToTitle does not take the ownership of the iterator
+    // (unlike ucasemap_setBreakIterator); it calls setUText() on each string
+    BreakIterator* briter = brkiter.getIterator();
+    const char* qloc = brkiter.getLocale();
     UErrorCode status = U_ZERO_ERROR;
-    ucasemap = ucasemap_open(brkiter.getLocale(), U_FOLD_CASE_DEFAULT, &status);
-    STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-
-    status = U_ZERO_ERROR;
-    ucasemap_setBreakIterator(ucasemap, brkiter.getIterator(), &status);
-    STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-    brkiter.free(false);
-    // ucasemap_setOptions(ucasemap, U_TITLECASE_NO_LOWERCASE, &status); // to do?
-    // now briter is owned by ucasemap.
-    // it will be released on ucasemap_close
-    // (checked with ICU man & src code)
 
     R_len_t str_n = LENGTH(str);
     StriContainerUTF8 str_cont(str, str_n);
@@ -106,14 +102,16 @@ SEXP stri_trans_totitle(SEXP str, SEXP opts_brkiter) {
         const char* str_cur_s = str_cont.get(i).c_str();
 
         status = U_ZERO_ERROR;
-        int buf_need = ucasemap_utf8ToTitle(ucasemap, buf.data(), buf.size(),
-                                            (const char*)str_cur_s, str_cur_n, &status);
+        int buf_need = CaseMap::utf8ToTitle(qloc, U_FOLD_CASE_DEFAULT, briter,
+                                            (const char*)str_cur_s, str_cur_n,
+                                            buf.data(), buf.size(), NULL, status);
 
         if (U_FAILURE(status)) {
             buf.resize(buf_need, false/*destroy contents*/);
             status = U_ZERO_ERROR;
-            buf_need = ucasemap_utf8ToTitle(ucasemap, buf.data(), buf.size(),
-                                            (const char*)str_cur_s, str_cur_n, &status);
+            buf_need = CaseMap::utf8ToTitle(qloc, U_FOLD_CASE_DEFAULT, briter,
+                                            (const char*)str_cur_s, str_cur_n,
+                                            buf.data(), buf.size(), NULL, status);
 
             STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */}) // this shouldn't happen
             // we do have the buffer size required to complete this op
@@ -122,22 +120,130 @@ SEXP stri_trans_totitle(SEXP str, SEXP opts_brkiter) {
         SET_STRING_ELT(ret, i, Rf_mkCharLenCE(buf.data(), buf_need, CE_UTF8));
     }
 
-    if (ucasemap) {
-        ucasemap_close(ucasemap);
-        ucasemap = NULL;
-    }
     STRI__UNPROTECT_ALL
     return ret;
 
-    STRI__ERROR_HANDLER_END({
-        if (ucasemap) {
-            ucasemap_close(ucasemap);
-            ucasemap = NULL;
+    STRI__ERROR_HANDLER_END({/* nothing special on error */})
+}
+
+
+/** Apply case mapping to a UTF-8 string
+ *
+ * @param ucasemap case map
+ * @param _type STRI_CASEMAP_TOLOWER, STRI_CASEMAP_TOUPPER,
+ *    or STRI_CASEMAP_CASEFOLD
+ * @param buf [in/out] output buffer, resized if necessary
+ * @param str_cur_s input string
+ * @param str_cur_n its length in bytes
+ * @return output length in bytes
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    separated from stri_trans_casemap
+ */
+static int stri__casemap_utf8(const UCaseMap* ucasemap, int _type,
+    String8buf& buf, const char* str_cur_s, R_len_t str_cur_n)
+{
+    int buf_need;
+    bool retry = false;
+    while (true) {
+        UErrorCode status = U_ZERO_ERROR;
+        if (_type == STRI_CASEMAP_TOLOWER) {
+            buf_need = ucasemap_utf8ToLower(
+                ucasemap, buf.data(), buf.size(),
+                (const char*)str_cur_s, str_cur_n, &status
+            );
         }
-    })
+        else if (_type == STRI_CASEMAP_TOUPPER) {
+            buf_need = ucasemap_utf8ToUpper(
+                ucasemap, buf.data(), buf.size(),
+                (const char*)str_cur_s, str_cur_n, &status
+            );
+        }
+        else {
+            buf_need = ucasemap_utf8FoldCase(
+                ucasemap, buf.data(), buf.size(),
+                (const char*)str_cur_s, str_cur_n, &status
+            );
+        }
+
+        if (!U_FAILURE(status)) break;
+
+        if (!retry) {
+            buf.resize(buf_need, false/*destroy contents*/);
+            // we now have the buffer size required to complete this op
+            retry = true;
+        }
+        else {
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */}) // this shouldn't happen
+        }
+    }
+
+    return buf_need;
 }
 
 
+/** help struct for stri_trans_casemap: case mapping
+ *  in parallel, each thread uses its own UCaseMap and buffer
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriCasemapWorker {
+    const StriContainerUTF8* cont;
+    int type;
+    std::vector<UCaseMap*> ucasemaps;
+    std::vector<String8buf*> bufs;
+    std::vector<std::string> result;
+
+    StriCasemapWorker(const StriContainerUTF8* _cont, R_len_t n, int _type,
+        const char* qloc, int nthreads)
+        : cont(_cont), type(_type), ucasemaps(nthreads, (UCaseMap*)NULL),
+          bufs(nthreads, (String8buf*)NULL), result(n)
+    {
+        try {
+            for (int t=0; t<nthreads; ++t) {
+                UErrorCode status = U_ZERO_ERROR;
+                ucasemaps[t] = ucasemap_open(qloc, U_FOLD_CASE_DEFAULT, &status);
+                STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+                bufs[t] = new String8buf(cont->getMaxNumBytes()+10);
+            }
+        }
+        catch (...) {
+            cleanup();
+            throw;
+        }
+    }
+
+    ~StriCasemapWorker()
+    {
+        cleanup();
+    }
+
+    void cleanup()
+    {
+        for (size_t t=0; t<ucasemaps.size(); ++t) {
+            if (ucasemaps[t]) {
+                ucasemap_close(ucasemaps[t]);
+                ucasemaps[t] = NULL;
+            }
+            if (bufs[t]) {
+                delete bufs[t];
+                bufs[t] = NULL;
+            }
+        }
+    }
+
+    void operator() (R_len_t i, int thread_id)
+    {
+        if (cont->isNA(i)) return;
+        const String8& cur = cont->get(i);
+        String8buf& buf = *bufs[thread_id];
+        int buf_need = stri__casemap_utf8(ucasemaps[thread_id], type, buf,
+            cur.c_str(), cur.length());
+        result[i].assign(buf.data(), buf_need);
+    }
+};
+
+
 /**
  *  Convert case (upper, lowercase, fold)
  *
@@ -180,6 +286,9 @@ SEXP stri_trans_totitle(SEXP str, SEXP opts_brkiter) {
  *
  * @version 1.6.1 (Marek Gagolewski, 2021-04-30)
  *    add casefold
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    parallel execution (stri_options(threads=...))
 */
 SEXP stri_trans_casemap(SEXP str, int _type, SEXP locale)
 {
@@ -206,6 +315,29 @@ SEXP stri_trans_casemap(SEXP str, int _type, SEXP locale)
     STRI__PROTECT(ret = Rf_allocVector(STRSXP, str_n));
 
 
+    int nthreads = stri__parallel_get_num_threads(str_n);
+    if (nthreads > 1) {
+        // each thread gets its own UCaseMap and buffer;
+        // the results are passed to R afterwards, on the main thread
+        StriCasemapWorker worker(&str_cont, str_n, _type, qloc, nthreads);
+        stri__parallel_for(str_n, nthreads, worker);
+
+        for (R_len_t i=0; i<str_n; ++i) {
+            if (str_cont.isNA(i))
+                SET_STRING_ELT(ret, i, NA_STRING);
+            else
+                SET_STRING_ELT(ret, i, Rf_mkCharLenCE(worker.result[i].data(),
+                    (int)worker.result[i].size(), CE_UTF8));
+        }
+
+        if (ucasemap) {
+            ucasemap_close(ucasemap);
+            ucasemap = NULL;
+        }
+        STRI__UNPROTECT_ALL
+        return ret;
+    }
+
     // STEP 1.
     // Estimate the required buffer length
     // Notice: The resulting number of code points may be larger or smaller than
@@ -228,41 +360,7 @@ SEXP stri_trans_casemap(SEXP str, int _type, SEXP locale)
         R_len_t str_cur_n     = str_cont.get(i).length();
         const char* str_cur_s = str_cont.get(i).c_str();
 
-        int buf_need;
-        bool retry = false;
-        while (true) {
-            status = U_ZERO_ERROR;
-            if (_type == STRI_CASEMAP_TOLOWER) {
-                buf_need = ucasemap_utf8ToLower(
-                    ucasemap, buf.data(), buf.size(),
-                    (const char*)str_cur_s, str_cur_n, &status
-                );
-            }
-            else if (_type == STRI_CASEMAP_TOUPPER) {
-                buf_need = ucasemap_utf8ToUpper(
-                    ucasemap, buf.data(), buf.size(),
-                    (const char*)str_cur_s, str_cur_n, &status
-                );
-            }
-            else {
-                buf_need = ucasemap_utf8FoldCase(
-                    ucasemap, buf.data(), buf.size(),
-                    (const char*)str_cur_s, str_cur_n, &status
-                );
-            }
-
-            if (!U_FAILURE(status)) break;
-
-            if (!retry) {
-                buf.resize(buf_need, false/*destroy contents*/);
-                // we now have the buffer size required to complete this op
-                retry = true;
-            }
-            else {
-                STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */}) // this shouldn't happen
-            }
-        }
-
+        int buf_need = stri__casemap_utf8(ucasemap, _type, buf, str_cur_s, str_cur_n);
         SET_STRING_ELT(ret, i, Rf_mkCharLenCE(buf.data(), buf_need, CE_UTF8));
     }
 
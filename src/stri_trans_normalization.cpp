@@ -30,8 +30,12 @@
  */
 
 #include "stri_stringi.h"
-#include "stri_container_utf16.h"
+#include "stri_container_utf8.h"
+#include "stri_parallel.h"
 #include <unicode/normalizer2.h>
+#include <unicode/bytestream.h>
+#include <string>
+#include <vector>
 
 
 #define STRI_UNINORM_NFC 10
@@ -94,6 +98,96 @@ const Normalizer2* stri__normalizer_get(int _type)
 }
 
 
+/** help struct for stri_trans_nf: normalizes the i-th string (in UTF-8)
+ *
+ * Strings that are already normalized (most often the case) are only
+ * quick-checked and left as-is.  Otherwise, normalizeUTF8 copies
+ * the normalized prefix verbatim and processes only the remaining part.
+ * Invalid UTF-8 strings are converted to UTF-16 first.
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriNormalizeWorker {
+    const StriContainerUTF8* cont;
+    const Normalizer2* normalizer;
+    bool ascii_normalized;           ///< are ASCII strings always normalized?
+    std::vector<std::string>* out;   ///< normalized strings
+    std::vector<char>* changed;      ///< is out[i] set? (not vector<bool>: written concurrently)
+
+    StriNormalizeWorker(const StriContainerUTF8* _cont, const Normalizer2* _normalizer,
+            bool _ascii_normalized, std::vector<std::string>* _out, std::vector<char>* _changed)
+        : cont(_cont), normalizer(_normalizer), ascii_normalized(_ascii_normalized),
+          out(_out), changed(_changed) { }
+
+    void operator() (R_len_t i, int /*thread_id*/)
+    {
+        if (cont->isNA(i)) return;
+        const String8& cur = cont->get(i);
+        if (ascii_normalized && cur.isASCII()) return;
+
+        UErrorCode status = U_ZERO_ERROR;
+        if (!stri__utf8_is_valid(cur.c_str(), cur.length())) {
+            // ill-formed sequences are replaced with U+FFFD, as in UTF-16
+            UnicodeString cur_u = UnicodeString::fromUTF8(
+                StringPiece(cur.c_str(), cur.length()));
+            UnicodeString cur_n = normalizer->normalize(cur_u, status);
+            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+            cur_n.toUTF8String((*out)[i]);
+            (*changed)[i] = 1;
+            return;
+        }
+
+        StringPiece cur_s(cur.c_str(), cur.length());
+        bool is_normalized = normalizer->isNormalizedUTF8(cur_s, status);
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        if (is_normalized) return;
+
+        StringByteSink<std::string> sink(&(*out)[i]);
+        normalizer->normalizeUTF8(0, cur_s, sink, NULL, status);
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        (*changed)[i] = 1;
+    }
+};
+
+
+/** help struct for stri_trans_isnf
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriIsNormalizedWorker {
+    const StriContainerUTF8* cont;
+    const Normalizer2* normalizer;
+    bool ascii_normalized;  ///< are ASCII strings always normalized?
+    int* ret_tab;
+
+    StriIsNormalizedWorker(const StriContainerUTF8* _cont, const Normalizer2* _normalizer,
+            bool _ascii_normalized, int* _ret_tab)
+        : cont(_cont), normalizer(_normalizer), ascii_normalized(_ascii_normalized),
+          ret_tab(_ret_tab) { }
+
+    void operator() (R_len_t i, int /*thread_id*/)
+    {
+        if (cont->isNA(i)) {
+            ret_tab[i] = NA_LOGICAL;
+            return;
+        }
+        const String8& cur = cont->get(i);
+        if (ascii_normalized && cur.isASCII()) {
+            ret_tab[i] = TRUE;
+            return;
+        }
+        UErrorCode status = U_ZERO_ERROR;
+        if (!stri__utf8_is_valid(cur.c_str(), cur.length()))
+            ret_tab[i] = normalizer->isNormalized(UnicodeString::fromUTF8(
+                StringPiece(cur.c_str(), cur.length())), status) ? TRUE : FALSE;
+        else
+            ret_tab[i] = normalizer->isNormalizedUTF8(
+                StringPiece(cur.c_str(), cur.length()), status) ? TRUE : FALSE;
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+    }
+};
+
+
 /**
  * Perform Unicode Normalization
  *
@@ -117,6 +211,10 @@ const Normalizer2* stri__normalizer_get(int _type)
  *
  * @version 0.6-1 (Marek Gagolewski, 2015-07-11)
  *    This is now an internal function
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    parallel execution (stri_options(threads=...));
+ *    work in UTF-8; return the strings that are already normalized as-is
  */
 SEXP stri_trans_nf(SEXP str, int type)
 {
@@ -136,18 +234,27 @@ SEXP stri_trans_nf(SEXP str, int type)
     R_len_t str_length = LENGTH(str);
 
     STRI__ERROR_HANDLER_BEGIN(1)
-    StriContainerUTF16 str_cont(str, str_length, false); // writable, no recycle
+    StriContainerUTF8 str_cont(str, str_length);
+    std::vector<std::string> out(str_length);
+    std::vector<char> changed(str_length, 0);
 
+    // Normalizer2 instances are thread-safe
+    StriNormalizeWorker worker(&str_cont, normalizer,
+        type != STRI_UNINORM_NFKC_CF, &out, &changed);
+    stri__parallel_for(str_length, stri__parallel_get_num_threads(str_length), worker);
+
+    SEXP ret;
+    STRI__PROTECT(ret = Rf_allocVector(STRSXP, str_length));
     for (R_len_t i=0; i<str_length; ++i) {
-        if (str_cont.isNA(i)) continue;
-        UErrorCode status = U_ZERO_ERROR;
-        str_cont.set(i, normalizer->normalize(str_cont.get(i), status));
-        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+        if (changed[i])
+            SET_STRING_ELT(ret, i, Rf_mkCharLenCE(out[i].data(), (int)out[i].size(), CE_UTF8));
+        else
+            SET_STRING_ELT(ret, i, str_cont.toR(i));  // NA or as-is
     }
 
     // normalizer shall not be deleted at all
     STRI__UNPROTECT_ALL
-    return str_cont.toR();
+    return ret;
     STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
 }
 
@@ -173,6 +280,10 @@ SEXP stri_trans_nf(SEXP str, int type)
  *
  * @version 0.6-1 (Marek Gagolewski, 2015-07-11)
  *    This is now an internal function
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    parallel execution (stri_options(threads=...));
+ *    quick-check in UTF-8
  */
 SEXP stri_trans_isnf(SEXP str, int type)
 {
@@ -183,28 +294,17 @@ SEXP stri_trans_isnf(SEXP str, int type)
     R_len_t str_length = LENGTH(str);
 
     STRI__ERROR_HANDLER_BEGIN(1)
-    StriContainerUTF16 str_cont(str, str_length);
+    StriContainerUTF8 str_cont(str, str_length);
 
     SEXP ret;
     STRI__PROTECT(ret = Rf_allocVector(LGLSXP, str_length));
     int* ret_tab = LOGICAL(ret);
 
-    for (R_len_t i = str_cont.vectorize_init();
-            i != str_cont.vectorize_end();
-            i = str_cont.vectorize_next(i))
-    {
-        if (str_cont.isNA(i)) {
-            ret_tab[i] = NA_LOGICAL;
-            continue;
-        }
-
-        // C API will not be faster here
-        // as it is a simple wrapper for C++ API
-
-        UErrorCode status = U_ZERO_ERROR;
-        ret_tab[i] = normalizer->isNormalized(str_cont.get(i), status) ? TRUE : FALSE;
-        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-    }
+    // C API will not be faster here
+    // as it is a simple wrapper for C++ API
+    StriIsNormalizedWorker worker(&str_cont, normalizer,
+        type != STRI_UNINORM_NFKC_CF, ret_tab);
+    stri__parallel_for(str_length, stri__parallel_get_num_threads(str_length), worker);
 
     // normalizer shall not be deleted at all
     STRI__UNPROTECT_ALL
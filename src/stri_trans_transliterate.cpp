@@ -32,11 +32,113 @@
 
 #include "stri_stringi.h"
 #include "stri_container_utf16.h"
+#include "stri_cache.h"
+#include "stri_parallel.h"
 #include <unicode/translit.h>
 #include <unicode/strenum.h>
 #include <string>
 
 
+/** Default capacity of the transliterator cache,
+ *  see stri_options(transliterator_cache_size=...)
+ */
+#define STRI__TRANSLITERATOR_CACHE_SIZE_DEFAULT 64
+
+
+/** A key to the transliterator cache
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriTransliteratorCacheKey {
+    UnicodeString id;  ///< transform identifier or rules
+    bool rules;
+    bool forward;
+
+    StriTransliteratorCacheKey(const UnicodeString& _id, bool _rules, bool _forward)
+        : id(_id), rules(_rules), forward(_forward) { }
+
+    bool operator<(const StriTransliteratorCacheKey& other) const {
+        if (rules != other.rules) return rules < other.rules;
+        if (forward != other.forward) return forward < other.forward;
+        return id < other.id;
+    }
+};
+
+
+struct StriTransliteratorDeleter {
+    void operator()(Transliterator* t) const { delete t; }
+};
+
+
+/** Transliterators shared by all the stri_trans_general calls */
+static StriLRUCache<StriTransliteratorCacheKey, Transliterator*, StriTransliteratorDeleter>
+    stri__transliterator_cache(STRI__TRANSLITERATOR_CACHE_SIZE_DEFAULT);
+
+StriCacheBase& stri__transliterator_cache_base = stri__transliterator_cache;
+
+
+/** Get a transliterator, reusing the process-wide cache if possible
+ *
+ * Building a transliterator (especially a compound or a rule-based one)
+ * is much more expensive than cloning an existing one.
+ *
+ * @param id transform identifier or rules
+ * @param rules whether id gives transliteration rules
+ * @param forward transliteration direction
+ * @param status [out] ICU error code
+ * @return a new Transliterator object (owned by the caller) or NULL on error
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static Transliterator* stri__transliterator_create(
+    const UnicodeString& id, bool rules, bool forward, UErrorCode& status
+) {
+    StriTransliteratorCacheKey key(id, rules, forward);
+    Transliterator* cached = stri__transliterator_cache.get(key);
+    if (cached) {
+        Transliterator* ret = cached->clone();
+        if (!ret) status = U_MEMORY_ALLOCATION_ERROR;
+        return ret;
+    }
+
+    Transliterator* trans;
+    UParseError parserr;
+    if (!rules)
+        trans = Transliterator::createInstance(
+            id,
+            (forward?UTRANS_FORWARD:UTRANS_REVERSE),
+            status
+        );
+    else
+        trans = Transliterator::createFromRules(
+            UnicodeString("Rule-based Transliterator"),  // can be anything
+            id,
+            (forward?UTRANS_FORWARD:UTRANS_REVERSE),
+            parserr,
+            status
+        );
+
+    if (U_FAILURE(status)) {
+        // do not cache incorrect transforms
+        if (trans) delete trans;
+        return NULL;
+    }
+
+    if (!trans) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+
+    if (stri__transliterator_cache.getCapacity() <= 0)
+        return trans;  // caching disabled
+
+    Transliterator* ret = trans->clone();
+    if (!ret) status = U_MEMORY_ALLOCATION_ERROR;
+    stri__transliterator_cache.put(key, trans);  // now owned by the cache
+    return ret;
+}
+
+
 /** List available transliterators
  *
  * @return character vector
@@ -92,6 +194,52 @@ SEXP stri_trans_list()
 }
 
 
+/** help struct for stri_trans_general: transliteration
+ *  in parallel, each thread uses its own clone of the Transliterator
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+struct StriTransliterateWorker {
+    StriContainerUTF16* str_cont;
+    std::vector<Transliterator*> trans; ///< trans[0] is not owned
+
+    StriTransliterateWorker(StriContainerUTF16* _str_cont,
+        Transliterator* _trans, int nthreads)
+        : str_cont(_str_cont), trans(nthreads, (Transliterator*)NULL)
+    {
+        trans[0] = _trans;
+        for (int t=1; t<nthreads; ++t) {
+            trans[t] = _trans->clone();
+            if (!trans[t]) {
+                cleanup();
+                throw StriException(MSG__MEM_ALLOC_ERROR);
+            }
+        }
+    }
+
+    ~StriTransliterateWorker()
+    {
+        cleanup();
+    }
+
+    void cleanup()
+    {
+        for (size_t t=1; t<trans.size(); ++t) {
+            if (trans[t]) {
+                delete trans[t];
+                trans[t] = NULL;
+            }
+        }
+    }
+
+    void operator() (R_len_t i, int thread_id)
+    {
+        if (str_cont->isNA(i)) return;
+        trans[thread_id]->transliterate(str_cont->getWritable(i));
+    }
+};
+
+
 /** General text transform with ICU Transliterator
  *
  * @param str character vector
@@ -102,6 +250,10 @@ SEXP stri_trans_list()
  *
  * @version 0.2-2 (Marek Gagolewski, 2014-04-19)
  * @version 1.6.3 (Marek Gagolewski, 2021-06-03)  rules, forward
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    use the transliterator cache;
+ *    parallel execution (stri_options(threads=...))
  */
 SEXP stri_trans_general(SEXP str, SEXP id, SEXP rules, SEXP forward)
 {
@@ -121,28 +273,21 @@ SEXP stri_trans_general(SEXP str, SEXP id, SEXP rules, SEXP forward)
     }
 
     UErrorCode status = U_ZERO_ERROR;
-    UParseError parserr;
-    if (!rules_val)
-        trans = Transliterator::createInstance(
-            id_cont.get(0),
-            (forward_val?UTRANS_FORWARD:UTRANS_REVERSE),
-            status
-        );
-    else
-        trans = Transliterator::createFromRules(
-            UnicodeString("Rule-based Transliterator"),  // can be anything
-            id_cont.get(0),
-            (forward_val?UTRANS_FORWARD:UTRANS_REVERSE),
-            parserr,
-            status
-        );
+    trans = stri__transliterator_create(id_cont.get(0), rules_val, forward_val, status);
     STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
 
     StriContainerUTF16 str_cont(str, str_length, false); // writable, no recycle
 
-    for (R_len_t i=0; i<str_length; ++i) {
-        if (str_cont.isNA(i)) continue;
-        trans->transliterate(str_cont.getWritable(i));
+    int nthreads = stri__parallel_get_num_threads(str_length);
+    if (nthreads > 1) {
+        StriTransliterateWorker worker(&str_cont, trans, nthreads);
+        stri__parallel_for(str_length, nthreads, worker);
+    }
+    else {
+        for (R_len_t i=0; i<str_length; ++i) {
+            if (str_cont.isNA(i)) continue;
+            trans->transliterate(str_cont.getWritable(i));
+        }
     }
 
     if (trans) {
@@ -158,3 +303,47 @@ SEXP stri_trans_general(SEXP str, SEXP id, SEXP rules, SEXP forward)
         }
     )
 }
+
+
+/** Build transliterators and store them in the cache
+ *  so that subsequent calls to stri_trans_general are faster
+ *
+ * @param id character vector
+ * @param rules single bool
+ * @param forward single bool
+ * @return R_NilValue
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+SEXP stri_trans_precompile(SEXP id, SEXP rules, SEXP forward)
+{
+    PROTECT(id = stri__prepare_arg_string(id, "id"));
+    bool rules_val = stri__prepare_arg_logical_1_notNA(rules, "rules");
+    bool forward_val = stri__prepare_arg_logical_1_notNA(forward, "forward");
+
+    R_len_t id_length = LENGTH(id);
+
+    Transliterator* trans = NULL;
+    STRI__ERROR_HANDLER_BEGIN(1)
+    StriContainerUTF16 id_cont(id, id_length);
+
+    for (R_len_t i=0; i<id_length; ++i) {
+        if (id_cont.isNA(i)) continue;
+
+        UErrorCode status = U_ZERO_ERROR;
+        trans = stri__transliterator_create(id_cont.get(i), rules_val, forward_val, status);
+        STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+        delete trans;
+        trans = NULL;
+    }
+
+    STRI__UNPROTECT_ALL
+    return R_NilValue;
+    STRI__ERROR_HANDLER_END(
+        if (trans) {
+            delete trans;
+            trans = NULL;
+        }
+    )
+}
@@ -0,0 +1,512 @@
+/* This file is part of the 'stringi' project.
+ * Copyright (c) 2013-2026, Marek Gagolewski <https://www.gagolewski.com/>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "stri_stringi.h"
+#include "stri_transcoder.h"
+
+// #define STRI__TRANSCODE_DISABLE_SIMD
+
+#if !defined(STRI__TRANSCODE_DISABLE_SIMD) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define STRI__TRANSCODE_SSE2
+#include <emmintrin.h>
+#endif
+
+
+#define STRI__TRANSCODE_ASCII_NONE  0
+#define STRI__TRANSCODE_ASCII_BYTE  1  // ASCII characters are single bytes
+#define STRI__TRANSCODE_ASCII_LE16  2  // ASCII characters are UTF-16LE code units
+
+
+/** Decodes UTF-8 */
+struct StriTranscoderDecUTF8 {
+    enum { MIN_BYTES = 1 };
+
+    inline bool next(const uint8_t*& s, const uint8_t* e, UChar32& c) const
+    {
+        int32_t i = 0;
+        int32_t n = (e-s > 4)?4:(int32_t)(e-s);
+        U8_NEXT(s, i, n, c);
+        if (c < 0) return false;
+        s += i;
+        return true;
+    }
+};
+
+
+/** Decodes UTF-16LE or UTF-16BE */
+template<bool LE> struct StriTranscoderDecUTF16 {
+    enum { MIN_BYTES = 2 };
+
+    static inline UChar unit(const uint8_t* s)
+    {
+        return LE?(UChar)(s[0]|(s[1]<<8)):(UChar)((s[0]<<8)|s[1]);
+    }
+
+    inline bool next(const uint8_t*& s, const uint8_t* e, UChar32& c) const
+    {
+        if (e-s < 2) return false;
+        UChar u = unit(s);
+        if (U16_IS_SINGLE(u)) {
+            c = u;
+            s += 2;
+            return true;
+        }
+        if (!U16_IS_LEAD(u) || e-s < 4) return false;
+        UChar u2 = unit(s+2);
+        if (!U16_IS_TRAIL(u2)) return false;
+        c = U16_GET_SUPPLEMENTARY(u, u2);
+        s += 4;
+        return true;
+    }
+};
+
+
+/** Decodes UTF-32LE or UTF-32BE */
+template<bool LE> struct StriTranscoderDecUTF32 {
+    enum { MIN_BYTES = 4 };
+
+    inline bool next(const uint8_t*& s, const uint8_t* e, UChar32& c) const
+    {
+        if (e-s < 4) return false;
+        uint32_t u = LE?
+            ((uint32_t)s[0]|((uint32_t)s[1]<<8)|((uint32_t)s[2]<<16)|((uint32_t)s[3]<<24)):
+            ((uint32_t)s[3]|((uint32_t)s[2]<<8)|((uint32_t)s[1]<<16)|((uint32_t)s[0]<<24));
+        if (u > 0x10FFFF || U_IS_SURROGATE(u)) return false;
+        c = (UChar32)u;
+        s += 4;
+        return true;
+    }
+};
+
+
+/** Decodes a single-byte code page */
+struct StriTranscoderDecSBCS {
+    enum { MIN_BYTES = 1 };
+    const UChar32* m_table;
+
+    StriTranscoderDecSBCS(const UChar32* table) : m_table(table) { }
+
+    inline bool next(const uint8_t*& s, const uint8_t* /*e*/, UChar32& c) const
+    {
+        c = m_table[*s];
+        if (c < 0) return false;
+        ++s;
+        return true;
+    }
+};
+
+
+/** Encodes UTF-8 */
+struct StriTranscoderEncUTF8 {
+    enum { MAX_BYTES = 4 };
+
+    inline bool put(UChar32 c, uint8_t*& t) const
+    {
+        int32_t i = 0;
+        U8_APPEND_UNSAFE(t, i, c);
+        t += i;
+        return true;
+    }
+};
+
+
+/** Encodes UTF-16LE or UTF-16BE */
+template<bool LE> struct StriTranscoderEncUTF16 {
+    enum { MAX_BYTES = 4 };
+
+    static inline void unit(UChar u, uint8_t* t)
+    {
+        t[LE?0:1] = (uint8_t)(u & 0xFF);
+        t[LE?1:0] = (uint8_t)(u >> 8);
+    }
+
+    inline bool put(UChar32 c, uint8_t*& t) const
+    {
+        if (c <= 0xFFFF) {
+            unit((UChar)c, t);
+            t += 2;
+        }
+        else {
+            unit(U16_LEAD(c), t);
+            unit(U16_TRAIL(c), t+2);
+            t += 4;
+        }
+        return true;
+    }
+};
+
+
+/** Encodes UTF-32LE or UTF-32BE */
+template<bool LE> struct StriTranscoderEncUTF32 {
+    enum { MAX_BYTES = 4 };
+
+    inline bool put(UChar32 c, uint8_t*& t) const
+    {
+        for (int k=0; k<4; ++k)
+            t[LE?k:(3-k)] = (uint8_t)((uint32_t)c >> (8*k));
+        t += 4;
+        return true;
+    }
+};
+
+
+/** Encodes a single-byte code page */
+struct StriTranscoderEncSBCS {
+    enum { MAX_BYTES = 1 };
+    const int16_t* m_table;
+
+    StriTranscoderEncSBCS(const int16_t* table) : m_table(table) { }
+
+    inline bool put(UChar32 c, uint8_t*& t) const
+    {
+        if (c > 0xFFFF || m_table[c] < 0) return false;
+        *(t++) = (uint8_t)m_table[c];
+        return true;
+    }
+};
+
+
+/** Copy a run of ASCII characters
+ *
+ * @param s [in/out] input
+ * @param e end of input
+ * @param t [in/out] output
+ * @param mode_in STRI__TRANSCODE_ASCII_BYTE or STRI__TRANSCODE_ASCII_LE16
+ * @param mode_out STRI__TRANSCODE_ASCII_BYTE or STRI__TRANSCODE_ASCII_LE16
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+static inline void stri__transcode_ascii_run(const uint8_t*& s, const uint8_t* e,
+    uint8_t*& t, int mode_in, int mode_out)
+{
+    if (mode_in == STRI__TRANSCODE_ASCII_BYTE) {
+#ifdef STRI__TRANSCODE_SSE2
+        for (; e-s >= 16; s += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*)s);
+            if (_mm_movemask_epi8(v) != 0) break;
+            if (mode_out == STRI__TRANSCODE_ASCII_BYTE) {
+                _mm_storeu_si128((__m128i*)t, v);
+                t += 16;
+            }
+            else {
+                const __m128i zero = _mm_setzero_si128();
+                _mm_storeu_si128((__m128i*)t, _mm_unpacklo_epi8(v, zero));
+                _mm_storeu_si128((__m128i*)(t+16), _mm_unpackhi_epi8(v, zero));
+                t += 32;
+            }
+        }
+#endif
+        if (mode_out == STRI__TRANSCODE_ASCII_BYTE) {
+            for (; s < e && *s < 0x80; ++s)
+                *(t++) = *s;
+        }
+        else {
+            for (; s < e && *s < 0x80; ++s) {
+                *(t++) = *s;
+                *(t++) = 0;
+            }
+        }
+    }
+    else {  // STRI__TRANSCODE_ASCII_LE16 -> STRI__TRANSCODE_ASCII_BYTE
+#ifdef STRI__TRANSCODE_SSE2
+        const __m128i nonascii = _mm_set1_epi16((short)0xFF80);
+        const __m128i zero = _mm_setzero_si128();
+        for (; e-s >= 16; s += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*)s);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, nonascii), zero)) != 0xFFFF)
+                break;
+            _mm_storel_epi64((__m128i*)t, _mm_packus_epi16(v, v));
+            t += 8;
+        }
+#endif
+        for (; e-s >= 2 && s[0] < 0x80 && s[1] == 0; s += 2)
+            *(t++) = s[0];
+    }
+}
+
+
+/** Convert a string, one code point at a time
+ *
+ * @param dec decoder
+ * @param enc encoder
+ * @param ascii_in, ascii_out STRI__TRANSCODE_ASCII_* modes
+ *    (ASCII runs are copied in bulk if both are not NONE)
+ * @param s input
+ * @param n number of bytes
+ * @param buf output buffer
+ * @param bufused [out] number of bytes written to \code{buf}
+ * @return false if the input is ill-formed or not representable in the
+ *    output encoding (\code{buf} is then undefined)
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+template<class Dec, class Enc>
+static bool stri__transcode(const Dec& dec, const Enc& enc,
+    int ascii_in, int ascii_out,
+    const char* s, R_len_t n, String8buf& buf, R_len_t& bufused)
+{
+    size_t bufneed = (size_t)(n/Dec::MIN_BYTES+1)*Enc::MAX_BYTES;
+    if (bufneed > (size_t)INT_MAX) return false;
+    buf.resize(bufneed, false/*destroy contents*/);
+
+    const uint8_t* cur = (const uint8_t*)s;
+    const uint8_t* end = cur+n;
+    uint8_t* t = (uint8_t*)buf.data();
+    bool ascii_runs = (ascii_in != STRI__TRANSCODE_ASCII_NONE &&
+        ascii_out != STRI__TRANSCODE_ASCII_NONE &&
+        !(ascii_in == STRI__TRANSCODE_ASCII_LE16 && ascii_out == STRI__TRANSCODE_ASCII_LE16));
+
+    while (cur < end) {
+        if (ascii_runs) {
+            stri__transcode_ascii_run(cur, end, t, ascii_in, ascii_out);
+            if (cur >= end) break;
+        }
+
+        UChar32 c;
+        if (!dec.next(cur, end, c) || !enc.put(c, t))
+            return false;
+    }
+
+    bufused = (R_len_t)(t-(uint8_t*)buf.data());
+    return true;
+}
+
+
+/** Dispatch on the output encoding; see stri__transcode */
+template<class Dec>
+static bool stri__transcode_to(StriTranscoder::Kind to, const int16_t* to_table,
+    const Dec& dec, int ascii_in, int ascii_out,
+    const char* s, R_len_t n, String8buf& buf, R_len_t& bufused)
+{
+    switch (to) {
+    case StriTranscoder::KIND_UTF8:
+        return stri__transcode(dec, StriTranscoderEncUTF8(), ascii_in, ascii_out, s, n, buf, bufused);
+    case StriTranscoder::KIND_UTF16LE:
+        return stri__transcode(dec, StriTranscoderEncUTF16<true>(), ascii_in, ascii_out, s, n, buf, bufused);
+    case StriTranscoder::KIND_UTF16BE:
+        return stri__transcode(dec, StriTranscoderEncUTF16<false>(), ascii_in, ascii_out, s, n, buf, bufused);
+    case StriTranscoder::KIND_UTF32LE:
+        return stri__transcode(dec, StriTranscoderEncUTF32<true>(), ascii_in, ascii_out, s, n, buf, bufused);
+    case StriTranscoder::KIND_UTF32BE:
+        return stri__transcode(dec, StriTranscoderEncUTF32<false>(), ascii_in, ascii_out, s, n, buf, bufused);
+    case StriTranscoder::KIND_SBCS:
+        return stri__transcode(dec, StriTranscoderEncSBCS(to_table), ascii_in, ascii_out, s, n, buf, bufused);
+    default:
+        return false;
+    }
+}
+
+
+/** Determine which direct converter can be used for a given ICU converter
+ *
+ * @param ucnv converter
+ * @return kind
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+StriTranscoder::Kind StriTranscoder::getKind(StriUcnv& ucnv)
+{
+    UConverter* uconv = ucnv.getConverter(false);
+    UErrorCode status = U_ZERO_ERROR;
+    const char* name = ucnv_getName(uconv, &status);
+    if (U_FAILURE(status) || !name || strchr(name, ',')) // e.g., ",version=1" adds a BOM
+        return KIND_NONE;
+
+    switch (ucnv_getType(uconv)) {
+    case UCNV_UTF8:                return KIND_UTF8;
+    case UCNV_UTF16_LittleEndian:  return KIND_UTF16LE;
+    case UCNV_UTF16_BigEndian:     return KIND_UTF16BE;
+    case UCNV_UTF32_LittleEndian:  return KIND_UTF32LE;
+    case UCNV_UTF32_BigEndian:     return KIND_UTF32BE;
+    case UCNV_SBCS:
+    case UCNV_LATIN_1:
+    case UCNV_US_ASCII:
+        return (ucnv_getMaxCharSize(uconv) == 1)?KIND_SBCS:KIND_NONE;
+    default:
+        return KIND_NONE;
+    }
+}
+
+
+/** Build the byte -> code point table
+ *
+ * @param name canonical converter name
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+void StriTranscoder::buildFromTable(const char* name)
+{
+    UErrorCode status = U_ZERO_ERROR;
+    UConverter* uconv = ucnv_open(name, &status);
+    if (U_FAILURE(status)) {
+        m_from = KIND_NONE;
+        return;
+    }
+    status = U_ZERO_ERROR;
+    ucnv_setToUCallBack(uconv, UCNV_TO_U_CALLBACK_STOP, NULL, NULL, NULL, &status);
+
+    m_from_table.assign(256, -1);
+    for (int b=0; b<256; ++b) {
+        char byte = (char)b;
+        UChar ubuf[4];
+        status = U_ZERO_ERROR;
+        int32_t len = ucnv_toUChars(uconv, ubuf, 4, &byte, 1, &status);
+        if (U_FAILURE(status) || len <= 0 || len > 2) continue;
+        int32_t i = 0;
+        UChar32 c;
+        U16_NEXT(ubuf, i, len, c);
+        if (i == len && !U_IS_SURROGATE(c))
+            m_from_table[b] = c;
+    }
+    ucnv_close(uconv);
+
+    m_from_ascii = true;
+    for (int b=0; b<128; ++b)
+        if (m_from_table[b] != b) m_from_ascii = false;
+}
+
+
+/** Build the code point -> byte table (the BMP only);
+ *  only round-trip mappings are included
+ *
+ * @param name canonical converter name
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+void StriTranscoder::buildToTable(const char* name)
+{
+    UErrorCode status = U_ZERO_ERROR;
+    UConverter* uconv = ucnv_open(name, &status);
+    if (U_FAILURE(status)) {
+        m_to = KIND_NONE;
+        return;
+    }
+    status = U_ZERO_ERROR;
+    ucnv_setToUCallBack(uconv, UCNV_TO_U_CALLBACK_STOP, NULL, NULL, NULL, &status);
+    status = U_ZERO_ERROR;
+    ucnv_setFromUCallBack(uconv, UCNV_FROM_U_CALLBACK_STOP, NULL, NULL, NULL, &status);
+
+    m_to_table.assign(0x10000, -1);
+    for (int b=0; b<256; ++b) {
+        char byte = (char)b;
+        UChar u;
+        status = U_ZERO_ERROR;
+        int32_t len = ucnv_toUChars(uconv, &u, 1, &byte, 1, &status);
+        if (U_FAILURE(status) || len != 1 || U_IS_SURROGATE(u)) continue;
+
+        char out[4];
+        status = U_ZERO_ERROR;
+        len = ucnv_fromUChars(uconv, out, 4, &u, 1, &status);
+        if (U_FAILURE(status) || len != 1 || (uint8_t)out[0] != b) continue;
+
+        m_to_table[u] = (int16_t)b;
+    }
+    ucnv_close(uconv);
+
+    m_to_ascii = true;
+    for (int c=0; c<128; ++c)
+        if (m_to_table[c] != c) m_to_ascii = false;
+}
+
+
+/** Prepare the direct conversion between two encodings
+ *
+ * @param from source encoding
+ * @param to target encoding
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+StriTranscoder::StriTranscoder(StriUcnv& from, StriUcnv& to)
+{
+    m_from = getKind(from);
+    m_to = getKind(to);
+    m_from_ascii = (m_from == KIND_UTF8);
+    m_to_ascii = (m_to == KIND_UTF8);
+    if (!isSupported()) return;
+
+    UErrorCode status = U_ZERO_ERROR;
+    if (m_from == KIND_SBCS)
+        buildFromTable(ucnv_getName(from.getConverter(false), &status));
+    status = U_ZERO_ERROR;
+    if (m_to == KIND_SBCS)
+        buildToTable(ucnv_getName(to.getConverter(false), &status));
+}
+
+
+/** Convert a string
+ *
+ * @param s input
+ * @param n number of bytes
+ * @param buf output buffer
+ * @param bufused [out] number of bytes written to \code{buf}
+ * @return false if the string cannot be converted directly
+ *    (ill-formed input, characters not representable
+ *    in the target encoding, unsupported encodings);
+ *    then the ICU converters should be used instead
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+bool StriTranscoder::convert(const char* s, R_len_t n, String8buf& buf, R_len_t& bufused) const
+{
+    if (!isSupported()) return false;
+
+    int ascii_in = m_from_ascii?STRI__TRANSCODE_ASCII_BYTE:
+        (m_from == KIND_UTF16LE?STRI__TRANSCODE_ASCII_LE16:STRI__TRANSCODE_ASCII_NONE);
+    int ascii_out = m_to_ascii?STRI__TRANSCODE_ASCII_BYTE:
+        (m_to == KIND_UTF16LE?STRI__TRANSCODE_ASCII_LE16:STRI__TRANSCODE_ASCII_NONE);
+    const int16_t* to_table = m_to_table.empty()?NULL:m_to_table.data();
+
+    switch (m_from) {
+    case KIND_UTF8:
+        return stri__transcode_to(m_to, to_table, StriTranscoderDecUTF8(),
+            ascii_in, ascii_out, s, n, buf, bufused);
+    case KIND_UTF16LE:
+        return stri__transcode_to(m_to, to_table, StriTranscoderDecUTF16<true>(),
+            ascii_in, ascii_out, s, n, buf, bufused);
+    case KIND_UTF16BE:
+        return stri__transcode_to(m_to, to_table, StriTranscoderDecUTF16<false>(),
+            ascii_in, ascii_out, s, n, buf, bufused);
+    case KIND_UTF32LE:
+        return stri__transcode_to(m_to, to_table, StriTranscoderDecUTF32<true>(),
+            ascii_in, ascii_out, s, n, buf, bufused);
+    case KIND_UTF32BE:
+        return stri__transcode_to(m_to, to_table, StriTranscoderDecUTF32<false>(),
+            ascii_in, ascii_out, s, n, buf, bufused);
+    case KIND_SBCS:
+        return stri__transcode_to(m_to, to_table, StriTranscoderDecSBCS(m_from_table.data()),
+            ascii_in, ascii_out, s, n, buf, bufused);
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,96 @@
+/* This file is part of the 'stringi' project.
+ * Copyright (c) 2013-2026, Marek Gagolewski <https://www.gagolewski.com/>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef __stri_transcoder_h
+#define __stri_transcoder_h
+
+
+#include "stri_stringi.h"
+#include "stri_string8buf.h"
+#include "stri_ucnv.h"
+#include <vector>
+
+
+/**
+ * Direct conversion between some common encodings, bypassing
+ * the UTF-16 intermediate representation used by the ICU converters
+ *
+ * Supported are UTF-8, UTF-16LE, UTF-16BE, UTF-32LE, UTF-32BE,
+ * and single-byte code pages (ISO-8859-x, windows-125x, KOI8-R, ...);
+ * the latter are handled via byte <-> code point tables
+ * built from the ICU converters.
+ *
+ * Only well-formed input that is fully representable in the output
+ * encoding is converted; otherwise convert() returns false and
+ * the caller should use ICU (which substitutes and warns).
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ */
+class StriTranscoder {
+
+public:
+
+    enum Kind {
+        KIND_NONE = 0,
+        KIND_UTF8,
+        KIND_UTF16LE,
+        KIND_UTF16BE,
+        KIND_UTF32LE,
+        KIND_UTF32BE,
+        KIND_SBCS
+    };
+
+private:
+
+    Kind m_from;
+    Kind m_to;
+    std::vector<UChar32> m_from_table;  // byte -> code point or -1 (KIND_SBCS)
+    std::vector<int16_t> m_to_table;    // BMP code point -> byte or -1 (KIND_SBCS)
+    bool m_from_ascii;  // ASCII bytes are mapped onto themselves
+    bool m_to_ascii;
+
+    static Kind getKind(StriUcnv& ucnv);
+    void buildFromTable(const char* name);
+    void buildToTable(const char* name);
+
+public:
+
+    StriTranscoder(StriUcnv& from, StriUcnv& to);
+
+    /** can the direct conversion be used at all? */
+    bool isSupported() const { return m_from != KIND_NONE && m_to != KIND_NONE; }
+
+    bool convert(const char* s, R_len_t n, String8buf& buf, R_len_t& bufused) const;
+};
+
+#endif
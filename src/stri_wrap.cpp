@@ -32,6 +32,7 @@
 
 #include "stri_stringi.h"
 #include "stri_container_utf8_indexable.h"
+#include "stri_brkiter.h"
 #include <deque>
 #include <vector>
 #include <utility>
@@ -98,6 +99,10 @@ void stri__wrap_greedy(std::deque<R_len_t>& wrap_after,
  * @version 0.4-1 (Marek Gagolewski, 2014-12-06)
  *    new args: add_para_1, add_para_n,
  *    cost of the last line is zero
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    linear memory use: no more nwords*nwords cost and where matrices;
+ *    only the words that fit in a line are considered as predecessors
  */
 void stri__wrap_dynamic(std::deque<R_len_t>& wrap_after,
                         R_len_t nwords, int width_val, double exponent_val,
@@ -105,83 +110,59 @@ void stri__wrap_dynamic(std::deque<R_len_t>& wrap_after,
                         const std::vector<R_len_t>& widths_trim,
                         int add_para_1, int add_para_n)
 {
-#define IDX(i,j) (i)*nwords+(j)
-    vector<double> cost(nwords*nwords);
-    // where cost[IDX(i,j)] == cost of printing words i..j in a single line, i<=j
-
-    // calculate costs:
-    // there is some "punishment" for leaving blanks at the end of each line
-    // (number of "blank" codepoints ^ exponent_val)
-    for (int i=0; i<nwords; i++) {
-        int sum = 0;
-        for (int j=i; j<nwords; j++) {
-            if (j > i) {
-                if (cost[IDX(i,j-1)] < 0.0) { // already Inf
-                    cost[IDX(i,j)] = -1.0; // Inf
-                    continue;
-                }
-                else {
-                    sum -= widths_trim[j-1];
-                    sum += widths_orig[j-1];
-                }
+    // the cost of printing words i..j in a single line is:
+    // 0 if j == nwords-1 (last line) and the words fit (or i == j),
+    // 0 if i == j and the word does not fit in a line at all,
+    // Inf if i < j and the words do not fit in a line,
+    // otherwise, there is some "punishment" for leaving blanks at the end
+    // of each line (number of "blank" codepoints ^ exponent_val)
+
+    std::vector<double> f(nwords); // f[j] == total cost of (optimally) printing words 0..j
+    std::vector<R_len_t> prev(nwords); // prev[j] == the word after which
+    // we wrap for the last time when (optimally) printing words 0..j; -1 if none
+
+    bool first_line_fits = true; // do words 0..j fit in the first line?
+    int first_line_sum = 0;      // total width of words 0..j-1
+    for (R_len_t j = 0; j < nwords; ++j) {
+        bool last = (j == nwords-1);
+
+        if (first_line_fits) {
+            int ct = width_val - add_para_1 - (first_line_sum + widths_trim[j]);
+            if (j == 0 || ct >= 0) {
+                // no breaking needed: words 0..j fit in one line
+                first_line_sum += widths_orig[j];
+                f[j] = (last || ct < 0) ? 0.0 : pow((double)ct, exponent_val);
+                prev[j] = -1;
+                continue;
             }
-            sum += widths_trim[j];
-            int ct = width_val - sum;
-            if (i == 0) ct -= add_para_1;
-            else        ct -= add_para_n;
-
-            if (j == nwords-1) { // last line == cost 0
-                if (j == i || ct >= 0)
-                    cost[IDX(i,j)] = 0.0;
-                else
-                    cost[IDX(i,j)] = -1.0/*Inf*/;
-            }
-            else if (j == i)
-                // some words don't fit in a line at all -> cost 0.0
-                cost[IDX(i,j)] = (ct < 0) ? 0.0 : pow((double)ct, exponent_val);
-            else
-                cost[IDX(i,j)] = (ct < 0) ? -1.0/*"Inf"*/ : pow((double)ct, exponent_val);
-        }
-    }
-
-    vector<double> f(nwords); // f[j] == total cost of  (optimally) printing words 0..j
-    vector<bool> where(nwords*nwords, false); // where[IDX(i,j)] == false iff
-    // we don't wrap after i-th word, i<=j
-    // when (optimally) printing words 0..j
-
-    for (int j=0; j<nwords; ++j) {
-        if (cost[IDX(0,j)] >= 0.0) {
-            // no breaking needed: words 0..j fit in one line
-            f[j] = cost[IDX(0,j)];
-            continue;
+            first_line_fits = false; // and so will not for any greater j
         }
 
-        // let i = optimal way of printing of words 0..i + printing i+1..j
-        int i = 0;
-        while (i <= j) {
-            if (cost[IDX(i+1,j)] >= 0.0) break;
-            ++i;
-        }
-
-        double best_i = f[i] + cost[IDX(i+1,j)];
-        for (int k=i+1; k<j; ++k) {
-            if (cost[IDX(k+1,j)] < 0.0) continue;
-            double best_cur = f[k] + cost[IDX(k+1,j)];
-            if (best_cur < best_i) {
-                best_i = best_cur;
-                i = k;
+        // find the optimal k: printing words 0..k + printing k+1..j;
+        // only the words that fit in the current line are considered,
+        // hence the time complexity is O(nwords * words_per_line)
+        // and the memory use is linear;
+        // ties are resolved in favour of the smallest k
+        int sum = widths_trim[j];
+        int ct = width_val - add_para_n - sum;
+        double best_cost = f[j-1] + ((last || ct < 0) ? 0.0 : pow((double)ct, exponent_val));
+        R_len_t best_k = j-1;
+        for (R_len_t k = j-2; k >= 0; --k) {
+            sum += widths_orig[k+1];
+            ct = width_val - add_para_n - sum;
+            if (ct < 0) break; // words k+1..j do not fit in a line
+            double cur_cost = f[k] + (last ? 0.0 : pow((double)ct, exponent_val));
+            if (cur_cost <= best_cost) {
+                best_cost = cur_cost;
+                best_k = k;
             }
         }
-        for (int k=0; k<i; ++k)
-            where[IDX(k,j)] = where[IDX(k,i)];
-        where[IDX(i,j)] = true;
-        f[j] = best_i;
+        f[j] = best_cost;
+        prev[j] = best_k;
     }
 
-    //result is in the last row of where...
-    for (int k=0; k<nwords; ++k)
-        if (where[IDX(k, nwords-1)])
-            wrap_after.push_back(k);
+    for (R_len_t k = prev[nwords-1]; k >= 0; k = prev[k])
+        wrap_after.push_front(k);
 }
 
 
@@ -241,6 +222,9 @@ struct StriWrapLineStart {
  *
  * @version 0.5-1 (Marek Gagolewski, 2015-06-09)
  *    BIGSKIP: no more CHARSXP on out on "" input
+ *
+ * @version 1.8.9.9001 (Marek Gagolewski, 2026-10-18)
+ *    reuse the cached line break iterators, see stri__brkiter_create
  */
 SEXP stri_wrap(SEXP str, SEXP width, SEXP cost_exponent,
                SEXP indent, SEXP exdent, SEXP prefix, SEXP initial, SEXP whitespace_only,
@@ -261,7 +245,6 @@ SEXP stri_wrap(SEXP str, SEXP width, SEXP cost_exponent,
 
 
     const char* qloc = stri__prepare_arg_locale(locale, "locale"); /* this is R_alloc'ed */
-    Locale loc = Locale::createFromName(qloc);
     PROTECT(str     = stri__prepare_arg_string(str, "str"));
     PROTECT(prefix  = stri__prepare_arg_string_1(prefix, "prefix"));
     PROTECT(initial = stri__prepare_arg_string_1(initial, "initial"));
@@ -271,7 +254,7 @@ SEXP stri_wrap(SEXP str, SEXP width, SEXP cost_exponent,
 
     STRI__ERROR_HANDLER_BEGIN(3)
     UErrorCode status = U_ZERO_ERROR;
-    briter = BreakIterator::createLineInstance(loc, status);
+    briter = stri__brkiter_create(UBRK_LINE, UnicodeString(), qloc, status);
     STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
 
     // NOTE: this is very invasive for there are very few dedicated brkiters!